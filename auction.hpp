@@ -0,0 +1,207 @@
+#ifndef FLOWS_COURSEWORK_AUCTION_HPP
+#define FLOWS_COURSEWORK_AUCTION_HPP
+
+#include "interfaces.hpp"
+#include "parallel_utils.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace assignment {
+
+// Bertsekas' auction for the maximum weight perfect matching between n left and n right vertices.
+// Unassigned left vertices bid for the right vertex of the best value, weight minus price, and
+// raise its price by the margin over the second best plus epsilon. Bids of a round are computed in
+// parallel against the same prices (Jacobi) and the highest bid for each right vertex wins.
+// Weights are multiplied by n + 1, so the epsilon-optimal assignment of the last phase, where
+// epsilon is 1, is optimal; every phase divides epsilon by ALPHA and keeps the prices. Without a
+// perfect matching prices rise past any bound of a feasible auction and the result is empty.
+template <typename DataType>
+class auction_assignment_solver {
+    static constexpr DataType INF = std::numeric_limits<DataType>::max();
+    static constexpr DataType ALPHA = 8;
+    static constexpr vertex_t NONE = std::numeric_limits<vertex_t>::max();
+
+    struct bid_t {
+        vertex_t target = NONE;
+        DataType price{};
+    };
+
+    std::size_t n_threads_m;
+    std::vector<std::size_t> offsets_m;
+    std::vector<vertex_t> targets_m;
+    std::vector<DataType> weights_m;
+    std::vector<DataType> prices_m;
+    std::vector<vertex_t> owners_m;
+    std::vector<vertex_t> assigned_m;
+    std::vector<vertex_t> bidders_m;
+    std::vector<vertex_t> next_bidders_m;
+    std::vector<bid_t> bids_m;
+    std::vector<vertex_t> winners_m;
+    DataType epsilon_m{};
+    DataType spread_m{};
+    DataType price_bound_m{};
+    DataType price_limit_m{};
+    DataType weight_m{};
+
+    void build(std::size_t n, const std::vector<cost_edge<DataType>> &edges) {
+        offsets_m.assign(n + 1, 0);
+        for (const auto &edge : edges) {
+            if (edge.capacity > DataType{}) {
+                ++offsets_m[edge.from + 1];
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            offsets_m[i + 1] += offsets_m[i];
+        }
+        targets_m.resize(offsets_m[n]);
+        weights_m.resize(offsets_m[n]);
+        std::vector<std::size_t> positions(offsets_m.begin(), offsets_m.end() - 1);
+        DataType lightest = INF;
+        DataType heaviest = -INF;
+        for (const auto &edge : edges) {
+            if (edge.capacity > DataType{}) {
+                std::size_t position = positions[edge.from]++;
+                targets_m[position] = edge.to;
+                weights_m[position] = edge.cost * static_cast<DataType>(n + 1);
+                lightest = std::min(lightest, weights_m[position]);
+                heaviest = std::max(heaviest, weights_m[position]);
+            }
+        }
+        spread_m = offsets_m[n] == 0 ? DataType{} : heaviest - lightest;
+    }
+
+    // price for u to take its best right vertex, margin over the second best plus epsilon; a
+    // vertex with a single choice pays the whole weight spread
+    [[nodiscard]] bid_t bid(vertex_t u) const {
+        bid_t result;
+        DataType best = -INF;
+        DataType second = -INF;
+        for (std::size_t i = offsets_m[u]; i < offsets_m[u + 1]; ++i) {
+            DataType value = weights_m[i] - prices_m[targets_m[i]];
+            if (value > best) {
+                second = best;
+                best = value;
+                result.target = targets_m[i];
+            } else if (value > second) {
+                second = value;
+            }
+        }
+        if (result.target != NONE) {
+            DataType margin = second == -INF ? spread_m : best - second;
+            result.price = prices_m[result.target] + margin + epsilon_m;
+        }
+        return result;
+    }
+
+    // one phase from an empty assignment, false if prices show there is no perfect matching
+    bool run_phase(std::size_t n) {
+        std::fill(owners_m.begin(), owners_m.end(), NONE);
+        DataType highest = *std::max_element(prices_m.begin(), prices_m.end());
+        price_limit_m = highest > INF / 2 - price_bound_m ? INF / 2 : highest + price_bound_m;
+        bidders_m.resize(n);
+        for (vertex_t u = 0; u < n; ++u) {
+            bidders_m[u] = u;
+        }
+
+        while (!bidders_m.empty()) {
+            bids_m.resize(bidders_m.size());
+            const std::size_t n_tasks = std::min(bidders_m.size(), 4 * n_threads_m);
+            parallel_utils::parallel_for(n_tasks, n_threads_m, [&](std::size_t task) {
+                std::size_t from = bidders_m.size() * task / n_tasks;
+                std::size_t to = bidders_m.size() * (task + 1) / n_tasks;
+                for (std::size_t i = from; i < to; ++i) {
+                    bids_m[i] = bid(bidders_m[i]);
+                }
+            });
+
+            next_bidders_m.clear();
+            for (std::size_t i = 0; i < bidders_m.size(); ++i) {
+                vertex_t target = bids_m[i].target;
+                if (target == NONE || bids_m[i].price > price_limit_m) {
+                    return false;
+                }
+                vertex_t &winner = winners_m[target];
+                if (winner == NONE || bids_m[i].price > bids_m[winner].price) {
+                    winner = i;
+                }
+            }
+            for (std::size_t i = 0; i < bidders_m.size(); ++i) {
+                vertex_t target = bids_m[i].target;
+                if (winners_m[target] != i) {
+                    next_bidders_m.push_back(bidders_m[i]);
+                    continue;
+                }
+                winners_m[target] = NONE;
+                if (owners_m[target] != NONE) {
+                    next_bidders_m.push_back(owners_m[target]);
+                }
+                owners_m[target] = bidders_m[i];
+                assigned_m[bidders_m[i]] = target;
+                prices_m[target] = bids_m[i].price;
+            }
+            std::swap(bidders_m, next_bidders_m);
+        }
+        return true;
+    }
+
+  public:
+    explicit auction_assignment_solver(
+        std::size_t n_threads = parallel_utils::default_threads_count())
+        : n_threads_m(std::max<std::size_t>(n_threads, 1)) {
+    }
+
+    // Edges go from left vertex from to right vertex to, both below n; those of positive capacity
+    // may be used, cost is the weight. Returns the right vertex of every left one, or nothing if
+    // there is no perfect matching.
+    std::vector<vertex_t> solve(std::size_t n, const std::vector<cost_edge<DataType>> &edges) {
+        build(n, edges);
+        prices_m.assign(n, DataType{});
+        owners_m.assign(n, NONE);
+        assigned_m.assign(n, NONE);
+        winners_m.assign(n, NONE);
+        weight_m = DataType{};
+
+        // while someone is unassigned, a feasible phase has an alternating path from every bid
+        // right vertex to one without bids, so no price rises by more than n steps of a weight
+        // spread and epsilon over the highest price the phase started with
+        epsilon_m = std::max<DataType>(1, spread_m / ALPHA);
+        DataType step = spread_m + epsilon_m + 1;
+        price_bound_m = step > INF / 4 / static_cast<DataType>(2 * n + 2)
+                            ? INF / 4
+                            : step * static_cast<DataType>(2 * n + 2);
+        while (n > 0) {
+            if (!run_phase(n)) {
+                return {};
+            }
+            if (epsilon_m == 1) {
+                break;
+            }
+            epsilon_m = std::max<DataType>(1, epsilon_m / ALPHA);
+        }
+
+        for (vertex_t u = 0; u < n; ++u) {
+            DataType best = -INF;
+            for (std::size_t i = offsets_m[u]; i < offsets_m[u + 1]; ++i) {
+                if (targets_m[i] == assigned_m[u]) {
+                    best = std::max(best, weights_m[i]);
+                }
+            }
+            weight_m += best / static_cast<DataType>(n + 1);
+        }
+        return assigned_m;
+    }
+
+    // weight of the last assignment
+    [[nodiscard]] DataType weight() const {
+        return weight_m;
+    }
+};
+
+} // namespace assignment
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_AUCTION_HPP
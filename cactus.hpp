@@ -0,0 +1,627 @@
+#ifndef FLOWS_COURSEWORK_CACTUS_HPP
+#define FLOWS_COURSEWORK_CACTUS_HPP
+
+#include "push_relabel_solvers.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace undirected_cuts {
+
+// Cactus of all global minimum cuts. One Hao-Orlin run on both directions of every edge takes
+// every sink next to the sources, so minimum cuts first separating the sources from a sink cannot
+// cross: crossing minimum cuts have no edge between their common part and the rest. They are the
+// sets closed under residual arcs of its preflow and form a chain kept in O(n); every minimum cut
+// is in the chain of its first sink. The cactus starts as one node and chains are inserted from
+// the last sink back: the root holds the sources of the chain, which splits it into a path whose
+// layers take over its own vertices, subtrees and cycles, and a root cycle whose lower nodes fall
+// into consecutive layers is one the path runs through. A chain takes O(m) to find and O(n) to
+// insert, with O(n^2) memory for all of them. A minimum cut is one tree edge or two edges of one
+// cycle, a range of vertices in a preorder of the cactus, so cuts are walked in amortized O(1),
+// listing takes O(n) per cut and membership is checked by O(n) dynamic programming.
+// Cuts of a disconnected graph are all unions of components and are kept without a cactus.
+template <typename DataType>
+class mincut_cactus {
+    using edges_t = std::vector<capacity_edge<DataType>>;
+    using solver_t = push_relabel_solvers::hao_orlin_mincut_solver<DataType>;
+
+    static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+    // a tree edge counts as two cycle edges
+    static constexpr std::size_t TREE_EDGE_COST = 2;
+
+    struct cycle_t {
+        std::size_t top = 0;
+        std::vector<std::size_t> lowers;
+        // the arc of all lower nodes is already the cut of the top node itself
+        bool whole_arc_repeated = false;
+    };
+
+    // cut j of a chain, for j from 1 to n_cuts, holds the vertices of rank below j; only vertices
+    // of rank below n_cuts are listed
+    struct chain_t {
+        std::size_t n_cuts = 0;
+        std::vector<std::pair<vertex_t, std::size_t>> ranks;
+    };
+
+    std::size_t n_vertices_m = 0;
+    DataType value_m = std::numeric_limits<DataType>::max();
+    bool connected_m = true;
+    std::size_t n_nodes_m = 0;
+    std::size_t n_mincuts_m = 0;
+    std::vector<std::size_t> node_of_m;
+    std::vector<std::size_t> tree_parents_m;
+    std::vector<std::vector<std::size_t>> tree_children_m;
+    std::vector<std::vector<std::size_t>> topped_cycles_m;
+    std::vector<cycle_t> cycles_m;
+    // vertices in preorder of nodes, own vertices of a node are [begin, own_end), its subtree is
+    // [begin, end), and lower nodes of a cycle are consecutive
+    std::vector<vertex_t> order_m;
+    std::vector<std::size_t> position_m;
+    std::vector<std::size_t> begin_m;
+    std::vector<std::size_t> own_end_m;
+    std::vector<std::size_t> end_m;
+    std::vector<std::size_t> node_order_m;
+
+    // components over edges of positive weight, the one of vertex 0 is 0
+    static std::vector<std::size_t> components(std::size_t n_vertices, const edges_t &edges) {
+        flows_utils::disjoint_sets components(n_vertices);
+        for (const auto &edge : edges) {
+            if (edge.capacity > DataType{}) {
+                components.unite(edge.from, edge.to);
+            }
+        }
+        return components.labels();
+    }
+
+    // chains of the sinks whose cut is minimum, in order of sinks
+    std::vector<chain_t> collect_chains(const edges_t &edges) {
+        edges_t directed = edges;
+        for (const auto &edge : edges) {
+            directed.emplace_back(edge.to, edge.from, edge.capacity);
+        }
+
+        std::vector<chain_t> chains;
+        solver_t solver;
+        solver.run_adjacent(n_vertices_m, directed, [&]() {
+            DataType excess = solver.excess(solver.sink());
+            if (excess < value_m) {
+                value_m = excess;
+                chains.clear();
+            }
+            if (excess == value_m) {
+                chains.push_back(sink_chain(solver));
+            }
+        });
+        return chains;
+    }
+
+    // A set holding the sink is a minimum cut against it iff it is closed against residual arcs
+    // and holds no source and no other vertex with excess, as only then the whole preflow across
+    // it reaches the sink. The smallest one holds the vertices reaching the sink, vertices reached
+    // from sources and excesses are never inside, and strongly connected components of the rest
+    // follow in topological order, which is unique since the cuts form a chain.
+    static chain_t sink_chain(const solver_t &solver) {
+        const auto &graph = solver.graph();
+        const std::size_t n = graph.size();
+        const std::size_t inside = NONE - 1;
+        std::vector<std::size_t> ranks(n, NONE);
+        std::vector<vertex_t> stack;
+
+        auto close = [&](vertex_t start, std::size_t rank, bool along) {
+            if (ranks[start] != NONE) {
+                return;
+            }
+            ranks[start] = rank;
+            stack.assign(1, start);
+            while (!stack.empty()) {
+                vertex_t current = stack.back();
+                stack.pop_back();
+                for (std::size_t i = 0; i < graph.degree(current); ++i) {
+                    const auto &edge = graph.get_edge_by_vertex(current, i);
+                    vertex_t other = graph.adjacent(current, edge);
+                    vertex_t from = along ? current : other;
+                    if (ranks[other] == NONE && graph.may_push(from, edge) > DataType{}) {
+                        ranks[other] = rank;
+                        stack.push_back(other);
+                    }
+                }
+            }
+        };
+        for (vertex_t v = 0; v < n; ++v) {
+            if (solver.is_source(v) || (v != solver.sink() && solver.excess(v) > DataType{})) {
+                close(v, inside, true);
+            }
+        }
+        close(solver.sink(), 0, false);
+
+        // Tarjan's algorithm, components come out in reverse topological order
+        std::vector<std::size_t> indices(n, NONE);
+        std::vector<std::size_t> lows(n);
+        std::vector<std::size_t> components(n, NONE);
+        std::vector<std::pair<vertex_t, std::size_t>> calls;
+        std::size_t n_indexed = 0;
+        std::size_t n_components = 0;
+        auto visit = [&](vertex_t v) {
+            indices[v] = lows[v] = n_indexed++;
+            stack.push_back(v);
+            calls.emplace_back(v, 0);
+        };
+        for (vertex_t root = 0; root < n; ++root) {
+            if (ranks[root] != NONE || indices[root] != NONE) {
+                continue;
+            }
+            visit(root);
+            while (!calls.empty()) {
+                vertex_t current = calls.back().first;
+                if (calls.back().second < graph.degree(current)) {
+                    const auto &edge = graph.get_edge_by_vertex(current, calls.back().second++);
+                    vertex_t other = graph.adjacent(current, edge);
+                    if (ranks[other] != NONE || graph.may_push(current, edge) <= DataType{}) {
+                        continue;
+                    }
+                    if (indices[other] == NONE) {
+                        visit(other);
+                    } else if (components[other] == NONE) {
+                        lows[current] = std::min(lows[current], indices[other]);
+                    }
+                    continue;
+                }
+
+                calls.pop_back();
+                if (lows[current] == indices[current]) {
+                    vertex_t member = n;
+                    while (member != current) {
+                        member = stack.back();
+                        stack.pop_back();
+                        components[member] = n_components;
+                    }
+                    ++n_components;
+                }
+                if (!calls.empty()) {
+                    std::size_t &parent_low = lows[calls.back().first];
+                    parent_low = std::min(parent_low, lows[current]);
+                }
+            }
+        }
+
+        chain_t chain;
+        chain.n_cuts = n_components + 1;
+        for (vertex_t v = 0; v < n; ++v) {
+            if (ranks[v] == 0) {
+                chain.ranks.emplace_back(v, 0);
+            } else if (ranks[v] == NONE) {
+                chain.ranks.emplace_back(v, n_components - components[v]);
+            }
+        }
+        return chain;
+    }
+
+    std::size_t add_node(vertex_t representative, std::vector<vertex_t> &representatives) {
+        tree_parents_m.push_back(NONE);
+        tree_children_m.emplace_back();
+        topped_cycles_m.emplace_back();
+        representatives.push_back(representative);
+        return n_nodes_m++;
+    }
+
+    // Splits the root into the path of the chain. The root keeps the last layer, which holds the
+    // sources; a layer holding one lower node of a root cycle continues the cycle the path runs
+    // through, and two such cycles in a row meet at an empty node.
+    void insert_chain(const chain_t &chain, std::vector<vertex_t> &root_vertices,
+                      std::vector<vertex_t> &representatives, std::vector<std::size_t> &ranks) {
+        struct layer_t {
+            std::vector<vertex_t> vertices;
+            std::vector<std::size_t> children;
+            std::vector<std::size_t> cycles;
+            std::size_t crossed_cycle = NONE;
+            std::size_t lower = NONE;
+        };
+
+        for (const auto &[v, rank] : chain.ranks) {
+            ranks[v] = rank;
+        }
+        auto layer_of = [&](vertex_t v) { return ranks[v] == NONE ? chain.n_cuts : ranks[v]; };
+
+        std::vector<layer_t> layers(chain.n_cuts + 1);
+        for (vertex_t v : root_vertices) {
+            layers[layer_of(v)].vertices.push_back(v);
+        }
+        for (std::size_t child : tree_children_m[0]) {
+            layers[layer_of(representatives[child])].children.push_back(child);
+        }
+        for (std::size_t c : topped_cycles_m[0]) {
+            const auto &lowers = cycles_m[c].lowers;
+            std::size_t first = layer_of(representatives[lowers[0]]);
+            if (first == layer_of(representatives[lowers[1]])) {
+                layers[first].cycles.push_back(c);
+                continue;
+            }
+            for (std::size_t lower : lowers) {
+                auto &layer = layers[layer_of(representatives[lower])];
+                layer.crossed_cycle = c;
+                layer.lower = lower;
+            }
+        }
+        tree_children_m[0].clear();
+        topped_cycles_m[0].clear();
+
+        std::size_t below = NONE;
+        bool below_empty = false;
+        std::size_t open_cycle = NONE;
+        for (std::size_t r = 0; r <= chain.n_cuts; ++r) {
+            auto &layer = layers[r];
+            if (layer.crossed_cycle != NONE) {
+                if (layer.crossed_cycle != open_cycle) {
+                    if (open_cycle != NONE) {
+                        std::size_t junction = add_node(representatives[below], representatives);
+                        cycles_m[open_cycle].top = junction;
+                        cycles_m[open_cycle].whole_arc_repeated = true;
+                        topped_cycles_m[junction].push_back(open_cycle);
+                        below = junction;
+                    }
+                    open_cycle = layer.crossed_cycle;
+                    cycles_m[open_cycle].lowers.assign(1, below);
+                }
+                cycles_m[open_cycle].lowers.push_back(layer.lower);
+                continue;
+            }
+            if (layer.vertices.empty() && layer.children.empty() && layer.cycles.empty()) {
+                continue;
+            }
+
+            std::size_t node = 0;
+            if (r < chain.n_cuts) {
+                vertex_t representative = 0;
+                if (!layer.vertices.empty()) {
+                    representative = layer.vertices[0];
+                } else if (!layer.children.empty()) {
+                    representative = representatives[layer.children[0]];
+                } else {
+                    representative = representatives[cycles_m[layer.cycles[0]].lowers[0]];
+                }
+                node = add_node(representative, representatives);
+            }
+            for (vertex_t v : layer.vertices) {
+                node_of_m[v] = node;
+            }
+            for (std::size_t child : layer.children) {
+                tree_parents_m[child] = node;
+                tree_children_m[node].push_back(child);
+            }
+            for (std::size_t c : layer.cycles) {
+                cycles_m[c].top = node;
+                topped_cycles_m[node].push_back(c);
+            }
+            if (open_cycle != NONE) {
+                cycles_m[open_cycle].top = node;
+                topped_cycles_m[node].push_back(open_cycle);
+                open_cycle = NONE;
+            } else if (node == 0 && below_empty &&
+                       tree_children_m[below].size() + topped_cycles_m[below].size() == 2) {
+                hang_triangle(below, representatives);
+            } else if (below != NONE) {
+                tree_parents_m[below] = node;
+                tree_children_m[node].push_back(below);
+            }
+            below = node;
+            below_empty = layer.vertices.empty();
+        }
+        root_vertices = std::move(layers[chain.n_cuts].vertices);
+
+        for (const auto &[v, rank] : chain.ranks) {
+            ranks[v] = NONE;
+        }
+    }
+
+    // An empty node with two branches below the root is a triangle with the root, and a later
+    // chain may run through it, so its branches become lower nodes of a root cycle. A branch that
+    // is a cycle hangs from an empty lower node, the node itself first. The node is the last one
+    // added, so it is dropped if nothing hangs from it.
+    void hang_triangle(std::size_t node, std::vector<vertex_t> &representatives) {
+        cycle_t &triangle = cycles_m.emplace_back();
+        for (std::size_t child : tree_children_m[node]) {
+            tree_parents_m[child] = NONE;
+            triangle.lowers.push_back(child);
+        }
+        tree_children_m[node].clear();
+        auto cycles = std::move(topped_cycles_m[node]);
+        topped_cycles_m[node].clear();
+        for (std::size_t c : cycles) {
+            vertex_t representative = representatives[cycles_m[c].lowers[0]];
+            std::size_t holder = node;
+            if (topped_cycles_m[node].empty()) {
+                representatives[node] = representative;
+            } else {
+                holder = add_node(representative, representatives);
+            }
+            cycles_m[c].top = holder;
+            cycles_m[c].whole_arc_repeated = true;
+            topped_cycles_m[holder].push_back(c);
+            triangle.lowers.push_back(holder);
+        }
+        if (topped_cycles_m[node].empty()) {
+            tree_parents_m.pop_back();
+            tree_children_m.pop_back();
+            topped_cycles_m.pop_back();
+            representatives.pop_back();
+            --n_nodes_m;
+        }
+        topped_cycles_m[0].push_back(cycles_m.size() - 1);
+    }
+
+    void build_cactus(const std::vector<chain_t> &chains) {
+        node_of_m.assign(n_vertices_m, 0);
+        n_nodes_m = 0;
+        std::vector<vertex_t> representatives;
+        add_node(0, representatives);
+        std::vector<vertex_t> root_vertices(n_vertices_m);
+        std::iota(root_vertices.begin(), root_vertices.end(), 0);
+        std::vector<std::size_t> ranks(n_vertices_m, NONE);
+        for (auto it = chains.rbegin(); it != chains.rend(); ++it) {
+            insert_chain(*it, root_vertices, representatives, ranks);
+        }
+
+        n_mincuts_m = 0;
+        for (std::size_t node = 1; node < n_nodes_m; ++node) {
+            n_mincuts_m += tree_parents_m[node] != NONE;
+        }
+        for (const auto &cycle : cycles_m) {
+            std::size_t k = cycle.lowers.size();
+            n_mincuts_m += k * (k + 1) / 2 - cycle.whole_arc_repeated;
+        }
+        build_order();
+    }
+
+    void build_order() {
+        std::vector<std::vector<vertex_t>> own(n_nodes_m);
+        for (vertex_t v = 0; v < n_vertices_m; ++v) {
+            own[node_of_m[v]].push_back(v);
+        }
+        std::vector<std::vector<std::size_t>> children(n_nodes_m);
+        for (std::size_t node = 0; node < n_nodes_m; ++node) {
+            children[node] = tree_children_m[node];
+            for (std::size_t c : topped_cycles_m[node]) {
+                children[node].insert(children[node].end(), cycles_m[c].lowers.begin(),
+                                      cycles_m[c].lowers.end());
+            }
+        }
+
+        order_m.clear();
+        node_order_m.clear();
+        begin_m.assign(n_nodes_m, 0);
+        own_end_m.assign(n_nodes_m, 0);
+        end_m.assign(n_nodes_m, 0);
+        std::vector<std::pair<std::size_t, std::size_t>> stack{{0, 0}};
+        while (!stack.empty()) {
+            auto &[node, child] = stack.back();
+            if (child == 0) {
+                node_order_m.push_back(node);
+                begin_m[node] = order_m.size();
+                order_m.insert(order_m.end(), own[node].begin(), own[node].end());
+                own_end_m[node] = order_m.size();
+            }
+            if (child == children[node].size()) {
+                end_m[node] = order_m.size();
+                stack.pop_back();
+                continue;
+            }
+            std::size_t next = children[node][child++];
+            stack.emplace_back(next, 0);
+        }
+        position_m.assign(n_vertices_m, 0);
+        for (std::size_t i = 0; i < n_vertices_m; ++i) {
+            position_m[order_m[i]] = i;
+        }
+    }
+
+    void build_components(const std::vector<std::size_t> &components) {
+        node_of_m = components;
+        n_nodes_m = *std::max_element(components.begin(), components.end()) + 1;
+        n_mincuts_m = n_nodes_m - 1 < std::numeric_limits<std::size_t>::digits
+                          ? (std::size_t{1} << (n_nodes_m - 1)) - 1
+                          : std::numeric_limits<std::size_t>::max();
+    }
+
+  public:
+    explicit mincut_cactus(std::size_t n_vertices, const edges_t &edges)
+        : n_vertices_m(n_vertices) {
+        if (n_vertices < 2) {
+            n_nodes_m = n_vertices;
+            node_of_m.assign(n_vertices, 0);
+            return;
+        }
+
+        auto parts = components(n_vertices, edges);
+        if (*std::max_element(parts.begin(), parts.end()) > 0) {
+            connected_m = false;
+            value_m = DataType{};
+            build_components(parts);
+            return;
+        }
+        build_cactus(collect_chains(edges));
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return n_vertices_m;
+    }
+
+    // maximum of DataType if there are less than two vertices
+    [[nodiscard]] DataType mincut_value() const {
+        return value_m;
+    }
+
+    // nodes of the cactus, components if the graph is disconnected, some nodes may be empty
+    [[nodiscard]] std::size_t nodes_count() const {
+        return n_nodes_m;
+    }
+
+    [[nodiscard]] std::size_t node_of(vertex_t v) const {
+        return node_of_m[v];
+    }
+
+    // whether some minimum cut separates u and v
+    [[nodiscard]] bool separable(vertex_t u, vertex_t v) const {
+        return node_of_m[u] != node_of_m[v];
+    }
+
+    // at most n (n - 1) / 2 for a connected graph, saturated at the maximum of std::size_t
+    [[nodiscard]] std::size_t mincuts_count() const {
+        return n_mincuts_m;
+    }
+
+    // calls callback(side) for every minimum cut once, side marks the part without vertex 0
+    template <typename Callback>
+    void for_each_mincut(Callback &&callback) const {
+        std::vector<bool> side(n_vertices_m);
+        if (!connected_m) {
+            // binary counter over components other than the one of vertex 0
+            std::vector<bool> chosen(n_nodes_m);
+            while (true) {
+                std::size_t component = 1;
+                while (component < n_nodes_m && chosen[component]) {
+                    chosen[component++] = false;
+                }
+                if (component == n_nodes_m) {
+                    return;
+                }
+                chosen[component] = true;
+                for (vertex_t v = 0; v < n_vertices_m; ++v) {
+                    side[v] = chosen[node_of_m[v]];
+                }
+                callback(static_cast<const std::vector<bool> &>(side));
+            }
+        }
+
+        mincut_walk walk;
+        std::pair<std::size_t, std::size_t> range;
+        while (next_mincut(walk, range)) {
+            for (std::size_t i = range.first; i < range.second; ++i) {
+                side[order_m[i]] = true;
+            }
+            callback(static_cast<const std::vector<bool> &>(side));
+            for (std::size_t i = range.first; i < range.second; ++i) {
+                side[order_m[i]] = false;
+            }
+        }
+    }
+
+    // position of v in the preorder, defined for a connected graph
+    [[nodiscard]] std::size_t position_of(vertex_t v) const {
+        return position_m[v];
+    }
+
+    // state of a walk over minimum cuts of a connected graph, a default one is at the start
+    struct mincut_walk {
+        std::size_t node = 1;
+        std::size_t cycle = 0;
+        std::size_t first = 0;
+        std::size_t last = 0;
+    };
+
+    // Moves walk to the next minimum cut in the order of for_each_mincut, one tree edge or one arc
+    // of a cycle. Its side without vertex 0 is the vertices with positions in [range.first,
+    // range.second); false once every cut has been walked or the graph is disconnected.
+    bool next_mincut(mincut_walk &walk, std::pair<std::size_t, std::size_t> &range) const {
+        if (!connected_m) {
+            return false;
+        }
+        for (; walk.node < n_nodes_m; ++walk.node) {
+            if (tree_parents_m[walk.node] != NONE) {
+                range = {begin_m[walk.node], end_m[walk.node]};
+                ++walk.node;
+                return true;
+            }
+        }
+        while (walk.cycle < cycles_m.size()) {
+            const auto &cycle = cycles_m[walk.cycle];
+            const auto &lowers = cycle.lowers;
+            std::size_t first = walk.first;
+            std::size_t last = walk.last;
+            if (++walk.last == lowers.size()) {
+                walk.last = ++walk.first;
+            }
+            if (walk.first == lowers.size()) {
+                ++walk.cycle;
+                walk.first = 0;
+                walk.last = 0;
+            }
+            if (cycle.whole_arc_repeated && first == 0 && last + 1 == lowers.size()) {
+                continue;
+            }
+            range = {begin_m[lowers[first]], end_m[lowers[last]]};
+            return true;
+        }
+        return false;
+    }
+
+    // Whether the vertices marked by side form a minimum cut. Sides of nodes are chosen bottom up
+    // to cut the fewest cactus edges, counting a tree edge as two cycle edges; the minimum is two
+    // exactly for minimum cuts.
+    [[nodiscard]] bool is_mincut(const std::vector<bool> &side) const {
+        auto marked = static_cast<std::size_t>(std::count(side.begin(), side.end(), true));
+        if (marked == 0 || marked == n_vertices_m) {
+            return false;
+        }
+        if (!connected_m) {
+            std::vector<char> seen(n_nodes_m, 2);
+            for (vertex_t v = 0; v < n_vertices_m; ++v) {
+                char &component = seen[node_of_m[v]];
+                if (component != 2 && component != side[v]) {
+                    return false;
+                }
+                component = side[v];
+            }
+            return true;
+        }
+
+        constexpr std::size_t INF = std::numeric_limits<std::size_t>::max() / 4;
+        std::vector<std::array<std::size_t, 2>> costs(n_nodes_m);
+        for (auto it = node_order_m.rbegin(); it != node_order_m.rend(); ++it) {
+            std::size_t node = *it;
+            for (bool node_side : {false, true}) {
+                std::size_t &cost = costs[node][node_side];
+                cost = 0;
+                for (std::size_t i = begin_m[node]; i < own_end_m[node]; ++i) {
+                    if (side[order_m[i]] != node_side) {
+                        cost = INF;
+                    }
+                }
+                for (std::size_t child : tree_children_m[node]) {
+                    cost = std::min(cost + std::min(costs[child][node_side],
+                                                    costs[child][!node_side] + TREE_EDGE_COST),
+                                    INF);
+                }
+                for (std::size_t c : topped_cycles_m[node]) {
+                    std::array<std::size_t, 2> path{0, INF};
+                    if (node_side) {
+                        std::swap(path[0], path[1]);
+                    }
+                    for (std::size_t lower : cycles_m[c].lowers) {
+                        std::array<std::size_t, 2> next{};
+                        for (bool lower_side : {false, true}) {
+                            next[lower_side] = std::min(
+                                costs[lower][lower_side] +
+                                    std::min(path[lower_side], path[!lower_side] + 1),
+                                INF);
+                        }
+                        path = next;
+                    }
+                    cost = std::min(cost + std::min(path[node_side], path[!node_side] + 1), INF);
+                }
+            }
+        }
+        return std::min(costs[0][0], costs[0][1]) == TREE_EDGE_COST;
+    }
+};
+
+} // namespace undirected_cuts
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_CACTUS_HPP
@@ -0,0 +1,174 @@
+#ifndef FLOWS_COURSEWORK_DENSE_SOLVERS_HPP
+#define FLOWS_COURSEWORK_DENSE_SOLVERS_HPP
+
+#include "dinics_solvers.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace dense_solvers {
+
+// Dinic's algorithm on an n x n matrix of residual capacities, parallel edges summed up. Rows are
+// contiguous, so the search for the next vertex of a layer scans a row together with the levels
+// in blocks of BLOCK entries without branches, and only looks at single entries of a block that
+// has a match. GCC does not vectorise the blocks; on complete graphs the first block usually has a
+// match, and vectorised blocks measured no faster. Edge flows are restored from the net flow of every
+// pair at the end, filling parallel edges in order.
+template <typename DataType>
+class dense_dinics_solver final : public flows_solver<DataType> {
+    static constexpr std::size_t UNREACHED = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t BLOCK = 16;
+
+    std::size_t n_vertices_m = 0;
+    vertex_t source_m = 0;
+    vertex_t target_m = 0;
+    std::vector<DataType> residuals_m;
+    std::vector<std::size_t> levels_m;
+    std::vector<vertex_t> iterators_m;
+    std::vector<vertex_t> queue_m;
+    std::vector<vertex_t> path_m;
+
+    [[nodiscard]] DataType *row(vertex_t u) {
+        return residuals_m.data() + u * n_vertices_m;
+    }
+
+    // first v from on with a residual edge from u and the given level, n if there is none
+    [[nodiscard]] vertex_t find_in_row(vertex_t u, vertex_t from, std::size_t level) {
+        const DataType *residuals = row(u);
+        const std::size_t *levels = levels_m.data();
+        vertex_t v = from;
+        for (; v + BLOCK <= n_vertices_m; v += BLOCK) {
+            bool found = false;
+            for (std::size_t i = 0; i < BLOCK; ++i) {
+                found |= (residuals[v + i] > DataType{}) & (levels[v + i] == level);
+            }
+            if (found) {
+                break;
+            }
+        }
+        for (; v < n_vertices_m; ++v) {
+            if (residuals[v] > DataType{} && levels[v] == level) {
+                return v;
+            }
+        }
+        return n_vertices_m;
+    }
+
+    // levels from the source up to the one of the target, false if it is unreachable
+    bool build_levels() {
+        levels_m.assign(n_vertices_m, UNREACHED);
+        levels_m[source_m] = 0;
+        queue_m.assign(1, source_m);
+        for (std::size_t i = 0; i < queue_m.size() && levels_m[target_m] == UNREACHED; ++i) {
+            vertex_t current = queue_m[i];
+            for (vertex_t v = find_in_row(current, 0, UNREACHED); v < n_vertices_m;
+                 v = find_in_row(current, v + 1, UNREACHED)) {
+                levels_m[v] = levels_m[current] + 1;
+                queue_m.push_back(v);
+            }
+        }
+        return levels_m[target_m] != UNREACHED;
+    }
+
+    // augments along shortest paths until the level graph is blocked
+    void blocking_flow() {
+        iterators_m.assign(n_vertices_m, 0);
+        path_m.assign(1, source_m);
+        while (!path_m.empty()) {
+            vertex_t current = path_m.back();
+            if (current == target_m) {
+                DataType amount = std::numeric_limits<DataType>::max();
+                for (std::size_t i = 0; i + 1 < path_m.size(); ++i) {
+                    amount = std::min(amount, row(path_m[i])[path_m[i + 1]]);
+                }
+                for (std::size_t i = 0; i + 1 < path_m.size(); ++i) {
+                    row(path_m[i])[path_m[i + 1]] -= amount;
+                    row(path_m[i + 1])[path_m[i]] += amount;
+                }
+                path_m.resize(1);
+                continue;
+            }
+            vertex_t &next = iterators_m[current];
+            next = find_in_row(current, next, levels_m[current] + 1);
+            if (next < n_vertices_m) {
+                path_m.push_back(next);
+                continue;
+            }
+            // a dead end leaves the level graph
+            levels_m[current] = UNREACHED;
+            path_m.pop_back();
+            if (!path_m.empty()) {
+                ++iterators_m[path_m.back()];
+            }
+        }
+    }
+
+  public:
+    std::vector<DataType> solve(std::size_t graph_size, vertex_t source, vertex_t target,
+                                const std::vector<capacity_edge<DataType>> &edges) override {
+        n_vertices_m = graph_size;
+        source_m = source;
+        target_m = target;
+        residuals_m.assign(graph_size * graph_size, DataType{});
+        for (const auto &edge : edges) {
+            if (edge.from != edge.to) {
+                row(edge.from)[edge.to] += edge.capacity;
+            }
+        }
+        while (source != target && build_levels()) {
+            blocking_flow();
+        }
+
+        // residual of u -> v minus its capacities is the net flow from v to u
+        for (const auto &edge : edges) {
+            if (edge.from != edge.to) {
+                row(edge.from)[edge.to] -= edge.capacity;
+            }
+        }
+        std::vector<DataType> result(edges.size());
+        for (edge_index_t i = 0; i < edges.size(); ++i) {
+            const auto &edge = edges[i];
+            DataType &remaining = row(edge.from)[edge.to];
+            if (edge.from != edge.to && remaining < DataType{}) {
+                result[i] = std::min(edge.capacity, -remaining);
+                remaining += result[i];
+            }
+        }
+        return result;
+    }
+};
+
+// Runs dense_dinics_solver when there are at least threshold edges per vertex pair, Sparse
+// otherwise.
+template <typename DataType, typename Sparse = dinics_solvers::basic_dinics_solver<DataType>>
+class density_aware_solver final : public flows_solver<DataType> {
+    double density_threshold_m;
+    dense_dinics_solver<DataType> dense_m;
+    Sparse sparse_m;
+
+  public:
+    // chosen by the sweep over random graphs of growing density, see readme: the matrix wins from
+    // about 0.05 and from 0.1 on takes less than twice the memory of flow_graph
+    static constexpr double DEFAULT_DENSITY_THRESHOLD = 0.1;
+
+    explicit density_aware_solver(double density_threshold = DEFAULT_DENSITY_THRESHOLD)
+        : density_threshold_m(density_threshold) {
+    }
+
+    std::vector<DataType> solve(std::size_t graph_size, vertex_t source, vertex_t target,
+                                const std::vector<capacity_edge<DataType>> &edges) override {
+        double pairs = static_cast<double>(graph_size) * static_cast<double>(graph_size);
+        if (static_cast<double>(edges.size()) >= density_threshold_m * pairs) {
+            return dense_m.solve(graph_size, source, target, edges);
+        }
+        return sparse_m.solve(graph_size, source, target, edges);
+    }
+};
+
+} // namespace dense_solvers
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_DENSE_SOLVERS_HPP
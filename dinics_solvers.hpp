@@ -162,10 +162,54 @@ class dinics_solver : public flows_solver<DataType> {
         ++next_edge_iterators_m[node];
     }
 
+    // number of layers between source and target, graph size if target is unreachable
+    [[nodiscard]] std::size_t level_depth() const {
+        return distances_m[graph_m.target()];
+    }
+
+    // finds one augmenting path in the layered network and pushes along it
+    bool augment_path() {
+        path_m.clear();
+        path_m.push_back(graph_m.source());
+        while (path_m.back() != graph_m.target()) {
+            if (vertex_t current = path_m.back(); iteration_finished(current)) {
+                if (current == graph_m.source()) {
+                    return false;
+                }
+                path_m.pop_back();
+                iterate(path_m.back());
+            } else if (const auto& edge = current_edge(current);
+                       !graph_m.may_push(current, edge)) {
+
+                iterate(current);
+            } else {
+                path_m.push_back(graph_m.adjacent(current, edge));
+            }
+        }
+        DataType max_pushable = graph_m.may_push(graph_m.source(), current_edge(graph_m.source()));
+
+        for (std::size_t i = 1; i + 1 < path_m.size(); ++i) {
+            vertex_t current = path_m[i];
+            max_pushable = std::min(graph_m.may_push(current, current_edge(current)), max_pushable);
+        }
+
+        for (std::size_t i = 0; i + 1 < path_m.size(); ++i) {
+            vertex_t current = path_m[i];
+            graph_m.push(current, current_edge(current), max_pushable);
+        }
+
+        return true;
+    }
+
+    // called once the layered network of a phase is built
+    virtual void start_phase() {
+    }
+
     virtual bool dfs_step() = 0;
 
     [[nodiscard]] virtual bool dfs_steps() {
         update_edges_to_next_layers();
+        start_phase();
         bool res = false;
         while (dfs_step()) {
             res = true;
@@ -173,6 +217,16 @@ class dinics_solver : public flows_solver<DataType> {
         return res;
     }
 
+    // flow that may still leave the source in the residual network
+    [[nodiscard]] DataType source_residual() const {
+        DataType res{};
+        for (std::size_t i = 0; i < graph_m.degree(graph_m.source()); ++i) {
+            res += graph_m.may_push(graph_m.source(),
+                                    graph_m.get_edge_by_vertex(graph_m.source(), i));
+        }
+        return res;
+    }
+
   public:
     std::vector<DataType> solve(std::size_t graph_size, vertex_t source, vertex_t target,
                                 const std::vector<capacity_edge<DataType>>& edges) override {
@@ -184,47 +238,47 @@ class dinics_solver : public flows_solver<DataType> {
 
         return flows_utils::flow_vector(graph_m);
     }
-};
 
-template <typename DataType>
-class basic_dinics_solver : public dinics_solver<DataType> {
-
-    std::vector<vertex_t> path_m;
+    // Value of the flow added to a prepared graph, which may already carry flow. Phases stop as
+    // soon as the value reaches limit, so a value below limit is the maximum one.
+    DataType flow_value(flow_graph graph,
+                        DataType limit = std::numeric_limits<DataType>::max()) {
+        graph_m = std::move(graph);
+        const DataType initial = source_residual();
+        DataType value{};
+        while (value < limit && dfs_steps()) {
+            value = initial - source_residual();
+        }
+        return value;
+    }
 
-  protected:
-    bool dfs_step() override {
-        path_m.clear();
-        path_m.push_back(this->graph_m.source());
-        while (path_m.back() != this->graph_m.target()) {
-            if (vertex_t current = path_m.back(); this->iteration_finished(current)) {
-                if (current == this->graph_m.source()) {
-                    return false;
+    // vertices reachable from the source in the residual network of the last graph, the source
+    // side of a minimum cut once the flow is maximum
+    [[nodiscard]] std::vector<bool> source_side() const {
+        std::vector<bool> reached(graph_m.size());
+        std::vector<vertex_t> stack{graph_m.source()};
+        reached[graph_m.source()] = true;
+        while (!stack.empty()) {
+            vertex_t current = stack.back();
+            stack.pop_back();
+            for (std::size_t i = 0; i < graph_m.degree(current); ++i) {
+                const auto& edge = graph_m.get_edge_by_vertex(current, i);
+                vertex_t other = graph_m.adjacent(current, edge);
+                if (!reached[other] && graph_m.may_push(current, edge)) {
+                    reached[other] = true;
+                    stack.push_back(other);
                 }
-                path_m.pop_back();
-                this->iterate(path_m.back());
-            } else if (const auto& edge = this->current_edge(current);
-                       !this->graph_m.may_push(current, edge)) {
-
-                this->iterate(current);
-            } else {
-                path_m.push_back(this->graph_m.adjacent(current, edge));
             }
         }
-        DataType max_pushable = this->graph_m.may_push(this->graph_m.source(),
-                                                       this->current_edge(this->graph_m.source()));
-
-        for (std::size_t i = 1; i + 1 < path_m.size(); ++i) {
-            vertex_t current = path_m[i];
-            max_pushable = std::min(this->graph_m.may_push(current, this->current_edge(current)),
-                                    max_pushable);
-        }
-
-        for (std::size_t i = 0; i + 1 < path_m.size(); ++i) {
-            vertex_t current = path_m[i];
-            this->graph_m.push(current, this->current_edge(current), max_pushable);
-        }
+        return reached;
+    }
+};
 
-        return true;
+template <typename DataType>
+class basic_dinics_solver : public dinics_solver<DataType> {
+  protected:
+    bool dfs_step() override {
+        return this->augment_path();
     }
 };
 
@@ -277,10 +331,21 @@ class scaled_dinics_solver final : public basic_dinics_solver<DataType> {
 };
 
 template <typename DataType>
-class linkcut_dinics_solver final : public dinics_solver<DataType> {
-    using link_cut = link_cut::link_cut<DataType>;
+using default_dynamic_tree = link_cut::link_cut<DataType, link_cut::min_aggregate<DataType>,
+                                                link_cut::add_update<DataType>,
+                                                link_cut::NO_OPTIONS>;
 
-    link_cut linkcut_m;
+template <typename DataType>
+using simple_splay_dynamic_tree =
+    link_cut::link_cut<DataType, link_cut::min_aggregate<DataType>, link_cut::add_update<DataType>,
+                       link_cut::SIMPLE_SPLAY>;
+
+// DynamicTree is a rooted forest with the interface of link_cut::link_cut: reinit, link_cut_link,
+// link_cut_cut, link_cut_parent, link_cut_root, link_cut_set, link_cut_get,
+// link_cut_add_on_path and link_cut_get_min_on_path.
+template <typename DataType, typename DynamicTree = default_dynamic_tree<DataType>>
+class linkcut_dinics_solver : public dinics_solver<DataType> {
+    DynamicTree linkcut_m;
     std::vector<bool> deleted_m;
 
     void mark_deleted(vertex_t vertex) {
@@ -300,11 +365,9 @@ class linkcut_dinics_solver final : public dinics_solver<DataType> {
     }
 
   protected:
-    bool dfs_steps() override {
+    void start_phase() override {
         linkcut_m.reinit(this->graph_m.size());
         deleted_m.assign(this->graph_m.size(), false);
-
-        return dinics_solver<DataType>::dfs_steps();
     }
 
     bool dfs_step() override {
@@ -365,6 +428,206 @@ class linkcut_dinics_solver final : public dinics_solver<DataType> {
     }
 };
 
+// Malhotra-Kumar-Maheshwari blocking flows in O(n^2) per phase. The potential of a vertex is the
+// least of the residual capacities entering and leaving it in the layered network. Each step
+// takes a vertex of minimum potential, pushes it layer by layer to the target and pulls it the
+// same way from the source, which always fits, then deletes vertices left with zero potential.
+template <typename DataType>
+class mpm_dinics_solver final : public dinics_solver<DataType> {
+    // edge number index in the adjacency of from
+    struct arc_t {
+        vertex_t from;
+        std::size_t index;
+    };
+
+    std::vector<std::vector<arc_t>> in_arcs_m;
+    std::vector<std::size_t> out_iterators_m;
+    std::vector<std::size_t> in_iterators_m;
+    std::vector<DataType> in_potentials_m;
+    std::vector<DataType> out_potentials_m;
+    std::vector<bool> deleted_m;
+    std::vector<DataType> amounts_m;
+    std::vector<vertex_t> queue_m;
+    std::vector<vertex_t> deletions_m;
+
+    [[nodiscard]] std::size_t out_arc_index(vertex_t vertex) const {
+        return this->next_edge_indices_m[vertex][out_iterators_m[vertex]];
+    }
+
+    [[nodiscard]] DataType potential(vertex_t vertex) const {
+        if (vertex == this->graph_m.source()) {
+            return out_potentials_m[vertex];
+        }
+        if (vertex == this->graph_m.target()) {
+            return in_potentials_m[vertex];
+        }
+        return std::min(in_potentials_m[vertex], out_potentials_m[vertex]);
+    }
+
+    // deletes queued vertices and those that lose their potential with them
+    void delete_vertices() {
+        while (!deletions_m.empty()) {
+            vertex_t vertex = deletions_m.back();
+            deletions_m.pop_back();
+            for (const auto& arc : in_arcs_m[vertex]) {
+                if (!deleted_m[arc.from]) {
+                    const auto& edge = this->graph_m.get_edge_by_vertex(arc.from, arc.index);
+                    out_potentials_m[arc.from] -= this->graph_m.may_push(arc.from, edge);
+                    schedule_deletion(arc.from);
+                }
+            }
+            for (edge_index_t index : this->next_edge_indices_m[vertex]) {
+                const auto& edge = this->graph_m.get_edge_by_vertex(vertex, index);
+                vertex_t adjacent = this->graph_m.adjacent(vertex, edge);
+                if (!deleted_m[adjacent]) {
+                    in_potentials_m[adjacent] -= this->graph_m.may_push(vertex, edge);
+                    schedule_deletion(adjacent);
+                }
+            }
+        }
+    }
+
+    void schedule_deletion(vertex_t vertex) {
+        if (!deleted_m[vertex] && potential(vertex) == DataType{}) {
+            deleted_m[vertex] = true;
+            deletions_m.push_back(vertex);
+        }
+    }
+
+    // moves amount of vertex towards the target, or from the source if forward is false
+    void route(vertex_t vertex, DataType amount, bool forward) {
+        vertex_t last = forward ? this->graph_m.target() : this->graph_m.source();
+        amounts_m[vertex] = amount;
+        queue_m.assign(1, vertex);
+        for (std::size_t i = 0; i < queue_m.size(); ++i) {
+            vertex_t current = queue_m[i];
+            DataType& left = amounts_m[current];
+            while (left > DataType{}) {
+                const arc_t arc = forward ? arc_t{current, out_arc_index(current)}
+                                          : in_arcs_m[current][in_iterators_m[current]];
+                auto& edge = this->graph_m.get_edge_by_vertex(arc.from, arc.index);
+                vertex_t head = this->graph_m.adjacent(arc.from, edge);
+                vertex_t other = forward ? head : arc.from;
+                DataType may_push =
+                    deleted_m[other] ? DataType{} : this->graph_m.may_push(arc.from, edge);
+                DataType pushed = std::min(left, may_push);
+                if (pushed > DataType{}) {
+                    this->graph_m.push(arc.from, edge, pushed);
+                    out_potentials_m[arc.from] -= pushed;
+                    in_potentials_m[head] -= pushed;
+                    if (amounts_m[other] == DataType{} && other != last) {
+                        queue_m.push_back(other);
+                    }
+                    amounts_m[other] += pushed;
+                    left -= pushed;
+                }
+                if (pushed == may_push) {
+                    ++(forward ? out_iterators_m : in_iterators_m)[current];
+                }
+            }
+        }
+        amounts_m[last] = DataType{};
+    }
+
+  protected:
+    void start_phase() override {
+        const std::size_t size = this->graph_m.size();
+        in_arcs_m.assign(size, {});
+        out_iterators_m.assign(size, 0);
+        in_iterators_m.assign(size, 0);
+        in_potentials_m.assign(size, DataType{});
+        out_potentials_m.assign(size, DataType{});
+        deleted_m.assign(size, false);
+        amounts_m.assign(size, DataType{});
+        for (vertex_t vertex = 0; vertex < size; ++vertex) {
+            for (edge_index_t index : this->next_edge_indices_m[vertex]) {
+                const auto& edge = this->graph_m.get_edge_by_vertex(vertex, index);
+                vertex_t adjacent = this->graph_m.adjacent(vertex, edge);
+                DataType may_push = this->graph_m.may_push(vertex, edge);
+                in_arcs_m[adjacent].push_back({vertex, index});
+                out_potentials_m[vertex] += may_push;
+                in_potentials_m[adjacent] += may_push;
+            }
+        }
+        for (vertex_t vertex = 0; vertex < size; ++vertex) {
+            schedule_deletion(vertex);
+        }
+        delete_vertices();
+    }
+
+    bool dfs_step() override {
+        if (deleted_m[this->graph_m.source()] || deleted_m[this->graph_m.target()]) {
+            return false;
+        }
+        vertex_t minimum = this->graph_m.source();
+        for (vertex_t vertex = 0; vertex < this->graph_m.size(); ++vertex) {
+            if (!deleted_m[vertex] && potential(vertex) < potential(minimum)) {
+                minimum = vertex;
+            }
+        }
+
+        DataType amount = potential(minimum);
+        if (minimum != this->graph_m.target()) {
+            route(minimum, amount, true);
+        }
+        if (minimum != this->graph_m.source()) {
+            route(minimum, amount, false);
+        }
+        amounts_m[minimum] = DataType{};
+        for (vertex_t vertex = 0; vertex < this->graph_m.size(); ++vertex) {
+            schedule_deletion(vertex);
+        }
+        delete_vertices();
+        return true;
+    }
+};
+
+// Augments along single paths while layered networks are shallow or blocking flows consist of few
+// paths, and switches to dynamic trees on phases that are deep and follow a phase with many
+// augmentations, where one blocking flow reuses long path prefixes.
+template <typename DataType, typename DynamicTree = default_dynamic_tree<DataType>>
+class hybrid_dinics_solver final : public linkcut_dinics_solver<DataType, DynamicTree> {
+    using linkcut_solver = linkcut_dinics_solver<DataType, DynamicTree>;
+
+    std::size_t depth_threshold_m;
+    std::size_t reuse_threshold_m;
+    std::size_t augmentations_m = 0;
+    bool use_dynamic_tree_m = false;
+
+  protected:
+    void start_phase() override {
+        std::size_t depth = this->level_depth();
+        use_dynamic_tree_m = depth >= depth_threshold_m && depth < this->graph_m.size() &&
+                             augmentations_m >= reuse_threshold_m;
+        augmentations_m = 0;
+        if (use_dynamic_tree_m) {
+            linkcut_solver::start_phase();
+        }
+    }
+
+    bool dfs_step() override {
+        bool result = use_dynamic_tree_m ? linkcut_solver::dfs_step() : this->augment_path();
+        augmentations_m += result;
+        return result;
+    }
+
+  public:
+    // chosen by the sweep over akc-hard, random-full and deep-fan tests, see readme
+    static constexpr std::size_t DEFAULT_DEPTH_THRESHOLD = 64;
+    static constexpr std::size_t DEFAULT_REUSE_THRESHOLD = 16;
+
+    explicit hybrid_dinics_solver(std::size_t depth_threshold = DEFAULT_DEPTH_THRESHOLD,
+                                  std::size_t reuse_threshold = DEFAULT_REUSE_THRESHOLD)
+        : depth_threshold_m(depth_threshold), reuse_threshold_m(reuse_threshold) {
+    }
+
+    std::vector<DataType> solve(std::size_t graph_size, vertex_t source, vertex_t target,
+                                const std::vector<capacity_edge<DataType>>& edges) override {
+        augmentations_m = 0;
+        return linkcut_solver::solve(graph_size, source, target, edges);
+    }
+};
+
 } // namespace dinics_solvers
 
 } // namespace flows_coursework
@@ -2,7 +2,11 @@
 #define FLOWS_COURSEWORK_FLOWS_UTILS_HPP
 
 #include "interfaces.hpp"
+#include <algorithm>
 #include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
 
 namespace flows_coursework {
 
@@ -59,6 +63,10 @@ struct flow_graph {
         return edges_buf_m[graph_m[u][i]];
     }
 
+    [[nodiscard]] edge_index_t get_edge_index(vertex_t u, std::size_t i) const {
+        return graph_m[u][i];
+    }
+
     edge_t &get_edge_by_index(edge_index_t index) {
         return edges_buf_m[index];
     }
@@ -92,6 +100,24 @@ struct flow_graph {
 
     flow_graph() : source_m(0), target_m(0), graph_m(1), edges_buf_m(0) {
     }
+
+    // Every edge may carry its capacity in both directions: it is stored once with doubled
+    // capacity and half of it as initial flow, so the residual is capacity +- flow either way.
+    [[nodiscard]] static flow_graph undirected(std::size_t n_vertices, vertex_t source,
+                                               vertex_t target,
+                                               const std::vector<capacity_edge<DataType>> &edges) {
+        flow_graph graph(n_vertices, source, target, edges);
+        for (auto &edge : graph.edges_buf_m) {
+            edge.flow_value = edge.capacity;
+            edge.capacity += edge.capacity;
+        }
+        return graph;
+    }
+
+    void set_terminals(vertex_t source, vertex_t target) {
+        source_m = source;
+        target_m = target;
+    }
 };
 
 template <typename DataType>
@@ -119,6 +145,221 @@ DataType flow_size(vertex_t source, const std::vector<capacity_edge<DataType>> &
     return res;
 }
 
+// Binary heap over vertices 0..n-1 with a key per vertex. Like std::priority_queue, top() is the
+// greatest vertex with respect to Compare. Keys of queued vertices may be changed in place.
+template <typename KeyType, typename Compare = std::less<KeyType>>
+class indexed_heap {
+    static constexpr std::size_t NOT_QUEUED = static_cast<std::size_t>(-1);
+
+    std::vector<vertex_t> heap_m;
+    std::vector<std::size_t> positions_m;
+    std::vector<KeyType> keys_m;
+    Compare compare_m;
+
+    [[nodiscard]] bool less(std::size_t i, std::size_t j) const {
+        return compare_m(keys_m[heap_m[i]], keys_m[heap_m[j]]);
+    }
+
+    void swap_positions(std::size_t i, std::size_t j) {
+        std::swap(heap_m[i], heap_m[j]);
+        positions_m[heap_m[i]] = i;
+        positions_m[heap_m[j]] = j;
+    }
+
+    void sift_up(std::size_t i) {
+        while (i > 0 && less((i - 1) / 2, i)) {
+            swap_positions(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void sift_down(std::size_t i) {
+        while (2 * i + 1 < heap_m.size()) {
+            std::size_t child = 2 * i + 1;
+            if (child + 1 < heap_m.size() && less(child, child + 1)) {
+                ++child;
+            }
+            if (!less(i, child)) {
+                break;
+            }
+            swap_positions(i, child);
+            i = child;
+        }
+    }
+
+  public:
+    explicit indexed_heap(std::size_t n = 0, Compare compare = Compare())
+        : positions_m(n, NOT_QUEUED), keys_m(n), compare_m(compare) {
+    }
+
+    // empties the heap, keeping allocated memory
+    void reinit(std::size_t n) {
+        heap_m.clear();
+        positions_m.assign(n, NOT_QUEUED);
+        keys_m.resize(n);
+    }
+
+    [[nodiscard]] bool empty() const {
+        return heap_m.empty();
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return heap_m.size();
+    }
+
+    [[nodiscard]] bool contains(vertex_t vertex) const {
+        return positions_m[vertex] != NOT_QUEUED;
+    }
+
+    [[nodiscard]] const KeyType &key(vertex_t vertex) const {
+        return keys_m[vertex];
+    }
+
+    [[nodiscard]] vertex_t top() const {
+        return heap_m.front();
+    }
+
+    void push(vertex_t vertex, KeyType key) {
+        keys_m[vertex] = key;
+        positions_m[vertex] = heap_m.size();
+        heap_m.push_back(vertex);
+        sift_up(heap_m.size() - 1);
+    }
+
+    void pop() {
+        swap_positions(0, heap_m.size() - 1);
+        positions_m[heap_m.back()] = NOT_QUEUED;
+        heap_m.pop_back();
+        if (!heap_m.empty()) {
+            sift_down(0);
+        }
+    }
+
+    // sets the key of a queued vertex
+    void update(vertex_t vertex, KeyType key) {
+        bool raised = compare_m(keys_m[vertex], key);
+        keys_m[vertex] = key;
+        if (raised) {
+            sift_up(positions_m[vertex]);
+        } else {
+            sift_down(positions_m[vertex]);
+        }
+    }
+};
+
+// Disjoint sets of 0..n-1 with path halving. unite hangs the root of the second set under the
+// root of the first, so a caller keeping data at roots knows where it ends up.
+class disjoint_sets {
+    std::vector<vertex_t> parents_m;
+    std::size_t n_sets_m = 0;
+
+  public:
+    disjoint_sets() = default;
+
+    explicit disjoint_sets(std::size_t n_elements) {
+        reinit(n_elements);
+    }
+
+    void reinit(std::size_t n_elements) {
+        parents_m.resize(n_elements);
+        std::iota(parents_m.begin(), parents_m.end(), 0);
+        n_sets_m = n_elements;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return parents_m.size();
+    }
+
+    [[nodiscard]] std::size_t sets_count() const {
+        return n_sets_m;
+    }
+
+    [[nodiscard]] vertex_t find(vertex_t element) {
+        while (parents_m[element] != element) {
+            parents_m[element] = parents_m[parents_m[element]];
+            element = parents_m[element];
+        }
+        return element;
+    }
+
+    // returns whether the sets were different
+    bool unite(vertex_t u, vertex_t v) {
+        u = find(u);
+        v = find(v);
+        if (u == v) {
+            return false;
+        }
+        parents_m[v] = u;
+        --n_sets_m;
+        return true;
+    }
+
+    // numbers sets in order of their smallest elements, the label of an element is that of its set
+    [[nodiscard]] std::vector<vertex_t> labels() {
+        std::vector<vertex_t> ids(size(), size());
+        std::vector<vertex_t> result(size());
+        std::size_t n_labels = 0;
+        for (vertex_t element = 0; element < size(); ++element) {
+            vertex_t root = find(element);
+            if (ids[root] == size()) {
+                ids[root] = n_labels++;
+            }
+            result[element] = ids[root];
+        }
+        return result;
+    }
+};
+
+// Undirected edges between labels of their ends, parallel edges summed and self-loops and edges of
+// zero weight dropped. Ends are ordered and edges are grouped by the smaller one; O(n + m).
+template <typename DataType>
+[[nodiscard]] std::vector<capacity_edge<DataType>>
+contracted_edges(std::size_t n_labels, const std::vector<capacity_edge<DataType>> &edges,
+                 const std::vector<vertex_t> &labels) {
+    std::vector<std::size_t> starts(n_labels + 1);
+    for (const auto &edge : edges) {
+        if (labels[edge.from] != labels[edge.to]) {
+            ++starts[std::min(labels[edge.from], labels[edge.to]) + 1];
+        }
+    }
+    std::partial_sum(starts.begin(), starts.end(), starts.begin());
+
+    std::vector<capacity_edge<DataType>> grouped(starts.back());
+    for (const auto &edge : edges) {
+        vertex_t u = labels[edge.from];
+        vertex_t v = labels[edge.to];
+        if (u != v) {
+            grouped[starts[std::min(u, v)]++] = {std::min(u, v), std::max(u, v), edge.capacity};
+        }
+    }
+
+    constexpr std::size_t NO_POSITION = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> positions(n_labels, NO_POSITION);
+    std::vector<capacity_edge<DataType>> result;
+    for (std::size_t begin = 0; begin < grouped.size();) {
+        std::size_t end = begin;
+        std::size_t first = result.size();
+        for (; end < grouped.size() && grouped[end].from == grouped[begin].from; ++end) {
+            auto &position = positions[grouped[end].to];
+            if (position == NO_POSITION) {
+                position = result.size();
+                result.push_back(grouped[end]);
+            } else {
+                result[position].capacity += grouped[end].capacity;
+            }
+        }
+        for (std::size_t i = begin; i < end; ++i) {
+            positions[grouped[i].to] = NO_POSITION;
+        }
+        result.erase(std::remove_if(result.begin() + static_cast<std::ptrdiff_t>(first),
+                                    result.end(),
+                                    [](const auto &edge) { return edge.capacity == DataType{}; }),
+                     result.end());
+        begin = end;
+    }
+    return result;
+}
+
 inline std::vector<capacity_edge<int64_t>> akc_test(int n) {
     std::vector<capacity_edge<int64_t>> data;
 
@@ -0,0 +1,210 @@
+#ifndef FLOWS_COURSEWORK_GOMORY_HU_HPP
+#define FLOWS_COURSEWORK_GOMORY_HU_HPP
+
+#include "dinics_solvers.hpp"
+#include "parallel_utils.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace undirected_cuts {
+
+// Gomory-Hu cut tree built by Gusfield's algorithm: vertex s > 0 is separated from its current
+// tree parent by a minimum cut of the original graph, and the parents of the vertices on its side
+// are moved to s. Flows of consecutive vertices are computed speculatively in parallel on copies
+// of one undirected flow graph; a flow is recomputed only if an earlier cut of its round moved
+// its parent. Every tree edge is a minimum cut between its ends, and min-cut(u, v) is the lightest
+// edge on the tree path, found by binary lifting.
+template <typename DataType>
+class gomory_hu_tree {
+    using edges_t = std::vector<capacity_edge<DataType>>;
+
+    struct cut_t {
+        vertex_t target = 0;
+        DataType value{};
+        std::vector<bool> side;
+    };
+
+    std::vector<vertex_t> parents_m;
+    std::vector<DataType> weights_m;
+    std::vector<std::size_t> depths_m;
+    // Euler tour bounds, v is in the subtree of u iff enter(u) <= enter(v) < leave(u)
+    std::vector<std::size_t> enter_m;
+    std::vector<std::size_t> leave_m;
+    // ancestors_m[k][v] is the 2^k-th ancestor of v, and lightest_m[k][v] is the vertex whose
+    // edge to its parent is the lightest on the way there
+    std::vector<std::vector<vertex_t>> ancestors_m;
+    std::vector<std::vector<vertex_t>> lightest_m;
+
+    void build_tree(std::size_t n_vertices, const edges_t &edges, std::size_t n_threads) {
+        parents_m.assign(n_vertices, 0);
+        weights_m.assign(n_vertices, std::numeric_limits<DataType>::max());
+        const auto prepared =
+            flows_utils::flow_graph<DataType>::undirected(n_vertices, 0, 0, edges);
+
+        for (vertex_t next = 1; next < n_vertices;) {
+            std::vector<cut_t> cuts(std::min(n_threads, n_vertices - next));
+            parallel_utils::parallel_for(cuts.size(), n_threads, [&](std::size_t i) {
+                auto graph = prepared;
+                cuts[i].target = parents_m[next + i];
+                graph.set_terminals(next + i, cuts[i].target);
+                dinics_solvers::basic_dinics_solver<DataType> solver;
+                cuts[i].value = solver.flow_value(std::move(graph));
+                cuts[i].side = solver.source_side();
+            });
+
+            // the first cut of a round is always valid
+            for (std::size_t i = 0; i < cuts.size() && parents_m[next] == cuts[i].target;
+                 ++i, ++next) {
+                apply_cut(next, cuts[i]);
+            }
+        }
+    }
+
+    void apply_cut(vertex_t source, const cut_t &cut) {
+        vertex_t target = cut.target;
+        weights_m[source] = cut.value;
+        for (vertex_t v = 0; v < parents_m.size(); ++v) {
+            if (v != source && cut.side[v] && parents_m[v] == target) {
+                parents_m[v] = source;
+            }
+        }
+        if (target != 0 && cut.side[parents_m[target]]) {
+            parents_m[source] = parents_m[target];
+            parents_m[target] = source;
+            weights_m[source] = weights_m[target];
+            weights_m[target] = cut.value;
+        }
+    }
+
+    void build_index() {
+        const std::size_t n = parents_m.size();
+        std::vector<std::vector<vertex_t>> children(n);
+        for (vertex_t v = 1; v < n; ++v) {
+            children[parents_m[v]].push_back(v);
+        }
+
+        depths_m.assign(n, 0);
+        enter_m.assign(n, 0);
+        leave_m.assign(n, 0);
+        std::size_t timer = 0;
+        std::vector<std::pair<vertex_t, std::size_t>> stack{{0, 0}};
+        enter_m[0] = timer++;
+        while (!stack.empty()) {
+            auto &[vertex, child] = stack.back();
+            if (child == children[vertex].size()) {
+                leave_m[vertex] = timer;
+                stack.pop_back();
+                continue;
+            }
+            vertex_t next = children[vertex][child++];
+            depths_m[next] = depths_m[vertex] + 1;
+            enter_m[next] = timer++;
+            stack.emplace_back(next, 0);
+        }
+
+        std::size_t levels = 1;
+        while ((std::size_t{1} << levels) < n) {
+            ++levels;
+        }
+        ancestors_m.assign(levels, std::vector<vertex_t>(n));
+        lightest_m.assign(levels, std::vector<vertex_t>(n));
+        for (vertex_t v = 0; v < n; ++v) {
+            ancestors_m[0][v] = parents_m[v];
+            lightest_m[0][v] = v;
+        }
+        for (std::size_t k = 1; k < levels; ++k) {
+            for (vertex_t v = 0; v < n; ++v) {
+                vertex_t middle = ancestors_m[k - 1][v];
+                ancestors_m[k][v] = ancestors_m[k - 1][middle];
+                lightest_m[k][v] = lighter(lightest_m[k - 1][v], lightest_m[k - 1][middle]);
+            }
+        }
+    }
+
+    [[nodiscard]] vertex_t lighter(vertex_t u, vertex_t v) const {
+        return weights_m[v] < weights_m[u] ? v : u;
+    }
+
+    // vertex whose edge to its parent is the lightest on the path between u != v
+    [[nodiscard]] vertex_t lightest_on_path(vertex_t u, vertex_t v) const {
+        if (depths_m[u] < depths_m[v]) {
+            std::swap(u, v);
+        }
+        vertex_t result = u;
+        for (std::size_t k = ancestors_m.size(); k-- > 0;) {
+            if (depths_m[u] - depths_m[v] >= (std::size_t{1} << k)) {
+                result = lighter(result, lightest_m[k][u]);
+                u = ancestors_m[k][u];
+            }
+        }
+        if (u == v) {
+            return result;
+        }
+        result = lighter(result, v);
+        for (std::size_t k = ancestors_m.size(); k-- > 0;) {
+            if (ancestors_m[k][u] != ancestors_m[k][v]) {
+                result = lighter(result, lighter(lightest_m[k][u], lightest_m[k][v]));
+                u = ancestors_m[k][u];
+                v = ancestors_m[k][v];
+            }
+        }
+        return lighter(result, lighter(u, v));
+    }
+
+  public:
+    explicit gomory_hu_tree(std::size_t n_vertices, const edges_t &edges,
+                            std::size_t n_threads = parallel_utils::default_threads_count()) {
+        if (n_vertices == 0) {
+            return;
+        }
+        build_tree(n_vertices, edges, std::max<std::size_t>(n_threads, 1));
+        build_index();
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return parents_m.size();
+    }
+
+    // tree parent of v != 0, vertex 0 is the root
+    [[nodiscard]] vertex_t parent(vertex_t v) const {
+        return parents_m[v];
+    }
+
+    // weight of the edge between v != 0 and its parent
+    [[nodiscard]] DataType parent_weight(vertex_t v) const {
+        return weights_m[v];
+    }
+
+    // weight of a minimum cut between u and v in O(log n), maximum of DataType if u == v
+    [[nodiscard]] DataType mincut(vertex_t u, vertex_t v) const {
+        if (u == v) {
+            return std::numeric_limits<DataType>::max();
+        }
+        return weights_m[lightest_on_path(u, v)];
+    }
+
+    // side of u of a minimum cut between u != v: the part of the tree with u after removing the
+    // lightest edge on the path
+    [[nodiscard]] std::vector<bool> cut_side(vertex_t u, vertex_t v) const {
+        vertex_t lightest = lightest_on_path(u, v);
+        auto in_subtree = [&](vertex_t w) {
+            return enter_m[lightest] <= enter_m[w] && enter_m[w] < leave_m[lightest];
+        };
+
+        bool u_inside = in_subtree(u);
+        std::vector<bool> side(size());
+        for (vertex_t w = 0; w < size(); ++w) {
+            side[w] = in_subtree(w) == u_inside;
+        }
+        return side;
+    }
+};
+
+} // namespace undirected_cuts
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_GOMORY_HU_HPP
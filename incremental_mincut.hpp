@@ -0,0 +1,153 @@
+#ifndef FLOWS_COURSEWORK_INCREMENTAL_MINCUT_HPP
+#define FLOWS_COURSEWORK_INCREMENTAL_MINCUT_HPP
+
+#include "cactus.hpp"
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace undirected_cuts {
+
+// Global minimum cut under edge insertions and weight increases. Insertions never lower a cut,
+// so minimum cuts of the last rebuild stay minimum while they separate no inserted edge. The cactus
+// of the last rebuild is kept and its cuts are walked as candidates, each a range of positions of
+// vertices. Ends of inserted edges are glued in a union-find, and the edges that merged two classes
+// form a forest of at most n - 1 edges; a candidate is dropped once it separates the ends of one
+// of them, and the cactus is rebuilt after the last one. While the graph is disconnected the
+// union-find holds its components instead, every union of them being a cut of weight 0.
+template <typename DataType>
+class incremental_mincut {
+    using edges_t = std::vector<capacity_edge<DataType>>;
+    using cactus_t = mincut_cactus<DataType>;
+
+    std::size_t n_vertices_m = 0;
+    edges_t edges_m;
+    DataType value_m = std::numeric_limits<DataType>::max();
+    flows_utils::disjoint_sets classes_m;
+    std::vector<std::pair<vertex_t, vertex_t>> glued_m;
+    cactus_t cactus_m{0, {}};
+    typename cactus_t::mincut_walk walk_m;
+    std::vector<bool> side_m;
+    std::size_t rebuilds_m = 0;
+
+    [[nodiscard]] bool splits_no_class(std::pair<std::size_t, std::size_t> range) const {
+        auto inside = [&](vertex_t v) {
+            std::size_t position = cactus_m.position_of(v);
+            return range.first <= position && position < range.second;
+        };
+        for (const auto &[u, v] : glued_m) {
+            if (inside(u) != inside(v)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void take_range(std::pair<std::size_t, std::size_t> range) {
+        for (vertex_t v = 0; v < n_vertices_m; ++v) {
+            std::size_t position = cactus_m.position_of(v);
+            side_m[v] = range.first <= position && position < range.second;
+        }
+    }
+
+    void separate_component() {
+        vertex_t leader = classes_m.find(0);
+        for (vertex_t v = 0; v < n_vertices_m; ++v) {
+            side_m[v] = classes_m.find(v) != leader;
+        }
+    }
+
+    void rebuild() {
+        ++rebuilds_m;
+        classes_m.reinit(n_vertices_m);
+        for (const auto &edge : edges_m) {
+            classes_m.unite(edge.from, edge.to);
+        }
+        side_m.assign(n_vertices_m, false);
+        if (classes_m.sets_count() > 1) {
+            value_m = DataType{};
+            separate_component();
+            return;
+        }
+
+        classes_m.reinit(n_vertices_m);
+        glued_m.clear();
+        cactus_m = cactus_t(n_vertices_m, edges_m);
+        value_m = cactus_m.mincut_value();
+        walk_m = {};
+        std::pair<std::size_t, std::size_t> range;
+        cactus_m.next_mincut(walk_m, range);
+        take_range(range);
+    }
+
+  public:
+    explicit incremental_mincut(std::size_t n_vertices, const edges_t &edges)
+        : n_vertices_m(n_vertices) {
+        for (const auto &edge : edges) {
+            if (edge.capacity > DataType{}) {
+                edges_m.push_back(edge);
+            }
+        }
+        if (n_vertices >= 2) {
+            rebuild();
+        }
+    }
+
+    // a weight increase of an edge is an insertion of a parallel edge, weight must be positive
+    void add_edge(vertex_t u, vertex_t v, DataType weight) {
+        edges_m.emplace_back(u, v, weight);
+        if (n_vertices_m < 2) {
+            return;
+        }
+        if (classes_m.unite(u, v)) {
+            glued_m.emplace_back(u, v);
+        }
+        if (side_m[u] == side_m[v]) {
+            return;
+        }
+
+        if (value_m == DataType{}) {
+            if (classes_m.sets_count() > 1) {
+                separate_component();
+            } else {
+                rebuild();
+            }
+            return;
+        }
+        std::pair<std::size_t, std::size_t> range;
+        while (cactus_m.next_mincut(walk_m, range)) {
+            if (splits_no_class(range)) {
+                take_range(range);
+                return;
+            }
+        }
+        rebuild();
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return n_vertices_m;
+    }
+
+    // maximum of DataType if there are less than two vertices
+    [[nodiscard]] DataType mincut_value() const {
+        return value_m;
+    }
+
+    // a minimum cut, true marks the side without vertex 0
+    [[nodiscard]] const std::vector<bool> &mincut_side() const {
+        return side_m;
+    }
+
+    // cactus constructions and component recounts so far, including the initial one
+    [[nodiscard]] std::size_t rebuilds_count() const {
+        return rebuilds_m;
+    }
+};
+
+} // namespace undirected_cuts
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_INCREMENTAL_MINCUT_HPP
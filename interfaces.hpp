@@ -22,6 +22,18 @@ struct capacity_edge {
     capacity_edge() = default;
 };
 
+// edge of a min-cost flow network, cost is paid per unit of flow and may be negative
+template <typename DataType>
+struct cost_edge : capacity_edge<DataType> {
+    DataType cost{};
+
+    cost_edge(vertex_t from, vertex_t to, DataType capacity, DataType cost)
+        : capacity_edge<DataType>(from, to, capacity), cost(cost) {
+    }
+
+    cost_edge() = default;
+};
+
 template <typename DataType>
 struct flows_solver {
     virtual std::vector<DataType> solve(std::size_t, vertex_t, vertex_t,
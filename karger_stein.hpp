@@ -0,0 +1,165 @@
+#ifndef FLOWS_COURSEWORK_KARGER_STEIN_HPP
+#define FLOWS_COURSEWORK_KARGER_STEIN_HPP
+
+#include "parallel_utils.hpp"
+#include "stoer_wagner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace undirected_cuts {
+
+// Karger-Stein recursive contraction. A graph is contracted to about n / sqrt(2) vertices twice
+// independently and both results are solved recursively. Graphs of at most exact_vertices are
+// solved by Stoer-Wagner: the contraction steps shrink small graphs by few vertices, and an exact
+// base removes most of the recursion tree. One run finds a fixed minimum cut with probability
+// Omega(1 / log n), so runs are repeated until the requested success probability is reached.
+// Runs are independent: run i is seeded with (seed, i) and runs are spread over threads, so the
+// answer depends only on the seed.
+template <typename DataType>
+class karger_stein_mincut_solver {
+    using edges_t = std::vector<capacity_edge<DataType>>;
+
+    struct cut_t {
+        DataType weight{};
+        std::vector<bool> side;
+    };
+
+    double success_probability_m;
+    std::uint64_t seed_m;
+    std::size_t n_threads_m;
+    std::size_t exact_vertices_m;
+
+    // Contracts edges in order of exponential keys with rates equal to their weights until
+    // target super-vertices are left, which picks each next edge with probability proportional
+    // to its weight. Fills labels with super-vertices and returns their number; fewer edges than
+    // needed mean that super-vertices are connected components.
+    [[nodiscard]] static std::size_t contract(std::size_t n_vertices, const edges_t &edges,
+                                              std::size_t target, std::mt19937_64 &generator,
+                                              std::vector<vertex_t> &labels) {
+        std::uniform_real_distribution<double> distribution;
+        std::vector<std::pair<double, edge_index_t>> order;
+        order.reserve(edges.size());
+        for (edge_index_t i = 0; i < edges.size(); ++i) {
+            if (edges[i].capacity > DataType{}) {
+                order.emplace_back(-std::log1p(-distribution(generator)) /
+                                       static_cast<double>(edges[i].capacity),
+                                   i);
+            }
+        }
+        // only a prefix of the order is usually needed, so edges are popped from a heap
+        std::make_heap(order.begin(), order.end(), std::greater<>());
+
+        flows_utils::disjoint_sets super_vertices(n_vertices);
+        while (!order.empty() && super_vertices.sets_count() > target) {
+            std::pop_heap(order.begin(), order.end(), std::greater<>());
+            const auto &edge = edges[order.back().second];
+            order.pop_back();
+            super_vertices.unite(edge.from, edge.to);
+        }
+
+        labels = super_vertices.labels();
+        return super_vertices.sets_count();
+    }
+
+    [[nodiscard]] cut_t recursive_contract(std::size_t n_vertices, const edges_t &edges,
+                                           std::mt19937_64 &generator) const {
+        if (n_vertices <= exact_vertices_m) {
+            cut_t cut;
+            cut.side = dense_stoer_wagner_mincut_solver<DataType>().find_mincut(n_vertices, edges);
+            cut.weight = cut_size(edges, cut.side);
+            return cut;
+        }
+
+        // at least one contraction, or graphs of 4 vertices would recurse on themselves
+        auto target = std::min(n_vertices - 1, static_cast<std::size_t>(std::ceil(
+                                                   1 + static_cast<double>(n_vertices) /
+                                                           std::sqrt(2.0))));
+        cut_t best{std::numeric_limits<DataType>::max(), {}};
+        std::vector<vertex_t> labels;
+
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            std::size_t n_super_vertices = contract(n_vertices, edges, target, generator, labels);
+            if (n_super_vertices > target) {
+                // super-vertex 0 is a connected component
+                best.weight = DataType{};
+                best.side.resize(n_vertices);
+                for (vertex_t v = 0; v < n_vertices; ++v) {
+                    best.side[v] = labels[v] == 0;
+                }
+                return best;
+            }
+
+            auto cut = recursive_contract(
+                n_super_vertices, flows_utils::contracted_edges(n_super_vertices, edges, labels),
+                generator);
+            if (cut.weight < best.weight) {
+                best.weight = cut.weight;
+                best.side.resize(n_vertices);
+                for (vertex_t v = 0; v < n_vertices; ++v) {
+                    best.side[v] = cut.side[labels[v]];
+                }
+            }
+        }
+        return best;
+    }
+
+  public:
+    static constexpr std::size_t DEFAULT_EXACT_VERTICES = 32;
+
+    // exact_vertices below 2 still leaves graphs of 2 vertices to Stoer-Wagner
+    explicit karger_stein_mincut_solver(
+        double success_probability = 0.99, std::uint64_t seed = 0,
+        std::size_t n_threads = parallel_utils::default_threads_count(),
+        std::size_t exact_vertices = DEFAULT_EXACT_VERTICES)
+        : success_probability_m(success_probability), seed_m(seed), n_threads_m(n_threads),
+          exact_vertices_m(std::max<std::size_t>(exact_vertices, 2)) {
+    }
+
+    // runs needed for the success probability, assuming a run succeeds with 1 / (log2(n) + 1)
+    [[nodiscard]] std::size_t runs_count(std::size_t n_vertices) const {
+        double failure = std::max(1 - success_probability_m, 1e-12);
+        double per_run = std::log2(static_cast<double>(std::max<std::size_t>(n_vertices, 2))) + 1;
+        return std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(-std::log(failure) *
+                                                                           per_run)));
+    }
+
+    [[nodiscard]] std::vector<bool> find_mincut(std::size_t n_vertices, const edges_t &edges) {
+        if (n_vertices < 2) {
+            return std::vector<bool>(n_vertices);
+        }
+
+        std::vector<vertex_t> identity(n_vertices);
+        std::iota(identity.begin(), identity.end(), 0);
+        const edges_t simple_edges = flows_utils::contracted_edges(n_vertices, edges, identity);
+
+        std::vector<cut_t> cuts(runs_count(n_vertices));
+        parallel_utils::parallel_for(cuts.size(), n_threads_m, [&](std::size_t run) {
+            std::seed_seq seed{seed_m & 0xffffffffU, seed_m >> 32, static_cast<std::uint64_t>(run)};
+            std::mt19937_64 generator(seed);
+            cuts[run] = recursive_contract(n_vertices, simple_edges, generator);
+        });
+
+        // first of the lightest cuts, independent of scheduling
+        std::size_t best = 0;
+        for (std::size_t run = 1; run < cuts.size(); ++run) {
+            if (cuts[run].weight < cuts[best].weight) {
+                best = run;
+            }
+        }
+        return cuts[best].side;
+    }
+};
+
+} // namespace undirected_cuts
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_KARGER_STEIN_HPP
@@ -1,6 +1,10 @@
 #ifndef FLOWS_COURSEWORK_LINK_CUT_HPP
 #define FLOWS_COURSEWORK_LINK_CUT_HPP
 
+#include "flows_utils.hpp"
+#include "parallel_utils.hpp"
+#include <algorithm>
+#include <limits>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -11,7 +15,220 @@ using vertex_t = std::size_t;
 
 namespace link_cut {
 
+// Options of link_cut, combined with bitwise or.
+inline constexpr unsigned NO_OPTIONS = 0;
+// Maintains sizes of splay subtrees so that link_cut_depth is available.
+inline constexpr unsigned TRACK_DEPTH = 1U << 0U;
+// Enables rerooting (evert) with lazy path reversal and the undirected operations built on it.
+// Splay nodes also keep the aggregate of their subtree in reversed order, which a pending reversal
+// swaps in, so combine keeps its orientation and tie-breaking after evert.
+inline constexpr unsigned EVERT = 1U << 1U;
+// Replaces splaying with single rotations of the accessed vertex to the root of its splay tree.
+// Each access does half as many rotations, but the amortised logarithmic bound is lost.
+inline constexpr unsigned SIMPLE_SPLAY = 1U << 2U;
+
+// Update policies describe lazy operations applied to every value on a path.
+// Each policy provides tag_t, identity, is_identity, compose (applies newer tag after the older
+// one) and apply (applies tag to the sum of count values).
+
+template <typename DataType>
+struct no_update {
+    static constexpr bool ENABLED = false;
+    using tag_t = DataType;
+};
+
+template <typename DataType>
+struct add_update {
+    static constexpr bool ENABLED = true;
+    using tag_t = DataType;
+
+    [[nodiscard]] static tag_t identity() {
+        return DataType{};
+    }
+
+    [[nodiscard]] static bool is_identity(const tag_t &tag) {
+        return tag == DataType{};
+    }
+
+    static void compose(tag_t &older, const tag_t &newer) {
+        older += newer;
+    }
+
+    static void apply(DataType &value, const tag_t &tag, std::size_t count) {
+        value += count == 1 ? tag : tag * static_cast<DataType>(count);
+    }
+};
+
+// Maps x to multiplier * x + addend. Min and max aggregates require non-negative multipliers.
 template <typename DataType>
+struct affine_update {
+    static constexpr bool ENABLED = true;
+
+    struct tag_t {
+        DataType multiplier{1};
+        DataType addend{};
+    };
+
+    [[nodiscard]] static tag_t identity() {
+        return tag_t{};
+    }
+
+    [[nodiscard]] static bool is_identity(const tag_t &tag) {
+        return tag.multiplier == DataType{1} && tag.addend == DataType{};
+    }
+
+    static void compose(tag_t &older, const tag_t &newer) {
+        older.multiplier = newer.multiplier * older.multiplier;
+        older.addend = newer.multiplier * older.addend + newer.addend;
+    }
+
+    static void apply(DataType &value, const tag_t &tag, std::size_t count) {
+        value = tag.multiplier * value + tag.addend * static_cast<DataType>(count);
+    }
+};
+
+// Aggregate policies describe values maintained over a path. Each policy provides aggregate_t,
+// make (aggregate of a single vertex), combine (upper part of a path goes first) and
+// apply (applies a lazy tag to the aggregate of size values).
+
+template <typename DataType>
+struct no_aggregate {
+    static constexpr bool ENABLED = false;
+    static constexpr bool NEEDS_SIZE = false;
+    using aggregate_t = DataType;
+};
+
+template <typename DataType>
+struct min_aggregate {
+    static constexpr bool ENABLED = true;
+    static constexpr bool NEEDS_SIZE = false;
+
+    struct aggregate_t {
+        vertex_t node{};
+        DataType result{};
+    };
+
+    [[nodiscard]] static aggregate_t make(vertex_t node, const DataType &value) {
+        return {node, value};
+    }
+
+    // ties are resolved in favour of the deepest vertex
+    [[nodiscard]] static aggregate_t combine(const aggregate_t &upper, const aggregate_t &lower) {
+        return lower.result <= upper.result ? lower : upper;
+    }
+
+    template <typename Update>
+    static void apply(aggregate_t &aggregate, const typename Update::tag_t &tag, std::size_t) {
+        Update::apply(aggregate.result, tag, 1);
+    }
+};
+
+template <typename DataType>
+struct max_aggregate {
+    static constexpr bool ENABLED = true;
+    static constexpr bool NEEDS_SIZE = false;
+
+    struct aggregate_t {
+        vertex_t node{};
+        DataType result{};
+    };
+
+    [[nodiscard]] static aggregate_t make(vertex_t node, const DataType &value) {
+        return {node, value};
+    }
+
+    // ties are resolved in favour of the deepest vertex
+    [[nodiscard]] static aggregate_t combine(const aggregate_t &upper, const aggregate_t &lower) {
+        return lower.result >= upper.result ? lower : upper;
+    }
+
+    template <typename Update>
+    static void apply(aggregate_t &aggregate, const typename Update::tag_t &tag, std::size_t) {
+        Update::apply(aggregate.result, tag, 1);
+    }
+};
+
+template <typename DataType>
+struct sum_aggregate {
+    static constexpr bool ENABLED = true;
+    static constexpr bool NEEDS_SIZE = true;
+    using aggregate_t = DataType;
+
+    [[nodiscard]] static aggregate_t make(vertex_t, const DataType &value) {
+        return value;
+    }
+
+    [[nodiscard]] static aggregate_t combine(const aggregate_t &upper, const aggregate_t &lower) {
+        return upper + lower;
+    }
+
+    template <typename Update>
+    static void apply(aggregate_t &aggregate, const typename Update::tag_t &tag,
+                      std::size_t size) {
+        Update::apply(aggregate, tag, size);
+    }
+};
+
+// Operations of link_cut_apply_batch, named after the link_cut methods they call.
+enum class operation_type { LINK, CUT, ROOT, SET, ADD, GET, UPDATE_ON_PATH, GET_ON_PATH };
+
+namespace detail {
+
+// Optional fields of splay nodes, empty when they are not needed.
+
+template <bool ENABLED>
+struct size_field {
+    std::size_t subtree_size = 1;
+};
+
+template <>
+struct size_field<false> {};
+
+template <bool ENABLED, typename TagType>
+struct lazy_field {
+    TagType lazy_data{};
+};
+
+template <typename TagType>
+struct lazy_field<false, TagType> {};
+
+template <bool ENABLED, typename AggregateType>
+struct aggregate_field {
+    AggregateType aggregate{};
+};
+
+template <typename AggregateType>
+struct aggregate_field<false, AggregateType> {};
+
+template <bool ENABLED, typename AggregateType>
+struct reversed_aggregate_field {
+    AggregateType reversed_aggregate{};
+};
+
+template <typename AggregateType>
+struct reversed_aggregate_field<false, AggregateType> {};
+
+template <bool ENABLED>
+struct reverse_field {
+    bool reversed = false;
+};
+
+template <>
+struct reverse_field<false> {};
+
+// parents are stored explicitly only for rooted trees, evert invalidates them
+template <bool ENABLED>
+struct parent_field {
+    vertex_t link_cut_parent = 0;
+};
+
+template <>
+struct parent_field<false> {};
+
+} // namespace detail
+
+template <typename DataType, typename Aggregate = min_aggregate<DataType>,
+          typename Update = add_update<DataType>, unsigned OPTIONS = TRACK_DEPTH>
 class link_cut {
     static constexpr vertex_t NO_VERTEX = 0;
     using child_type = bool;
@@ -19,26 +236,28 @@ class link_cut {
     static constexpr child_type LEFT = true;
     static constexpr child_type RIGHT = false;
 
-    struct subtree_min_t {
-        vertex_t node = NO_VERTEX;
-        DataType result{};
-
-        subtree_min_t() = default;
-        subtree_min_t(vertex_t node, DataType result) : node(node), result(result) {
-        }
-    };
-
-    struct splay_node {
+    static constexpr bool HAS_AGGREGATE = Aggregate::ENABLED;
+    static constexpr bool HAS_LAZY = Update::ENABLED;
+    static constexpr bool HAS_SIZE =
+        (OPTIONS & TRACK_DEPTH) != 0 || (HAS_AGGREGATE && HAS_LAZY && Aggregate::NEEDS_SIZE);
+    static constexpr bool HAS_EVERT = (OPTIONS & EVERT) != 0;
+    static constexpr bool HAS_SIMPLE_SPLAY = (OPTIONS & SIMPLE_SPLAY) != 0;
+
+    using aggregate_t = typename Aggregate::aggregate_t;
+    using tag_t = typename Update::tag_t;
+
+    struct splay_node : detail::size_field<HAS_SIZE>,
+                        detail::lazy_field<HAS_LAZY, tag_t>,
+                        detail::aggregate_field<HAS_AGGREGATE, aggregate_t>,
+                        detail::reversed_aggregate_field<HAS_EVERT && HAS_AGGREGATE, aggregate_t>,
+                        detail::reverse_field<HAS_EVERT>,
+                        detail::parent_field<!HAS_EVERT> {
         vertex_t left = NO_VERTEX;
         vertex_t right = NO_VERTEX;
         vertex_t parent = NO_VERTEX;
-        std::size_t subtree_size = 1;
-        vertex_t link_cut_parent = NO_VERTEX;
         vertex_t extra_parent = NO_VERTEX;
 
         DataType data{};
-        DataType lazy_data{};
-        subtree_min_t subtree_min{};
 
         splay_node() = default;
     };
@@ -65,48 +284,140 @@ class link_cut {
         return nodes_m[node].link_cut_parent;
     }
 
-    void update(vertex_t node) {
-        if (node) {
-            vertex_t left = get_child<LEFT>(node);
-            vertex_t right = get_child<RIGHT>(node);
+    // extreme vertex of the splay tree of node in direction CHILD_TYPE
+    template <child_type CHILD_TYPE>
+    [[nodiscard]] vertex_t extreme(vertex_t node) {
+        if constexpr (HAS_EVERT) {
+            lazy_update(node);
+        }
+        vertex_t child;
+        while ((child = get_child<CHILD_TYPE>(node))) {
+            node = child;
+            if constexpr (HAS_EVERT) {
+                lazy_update(node);
+            }
+        }
+        return node;
+    }
 
-            nodes_m[node].subtree_size =
-                1 + nodes_m[left].subtree_size + nodes_m[right].subtree_size;
+    void evert(vertex_t node) {
+        expose(node);
+        splay(node);
+        nodes_m[node].reversed = true;
+    }
 
-            subtree_min_t left_subtree_min = nodes_m[left].subtree_min;
-            subtree_min_t right_subtree_min = nodes_m[right].subtree_min;
+    [[nodiscard]] std::size_t get_size(vertex_t node) const {
+        if constexpr (HAS_SIZE) {
+            return node ? nodes_m[node].subtree_size : 0;
+        } else {
+            return 0;
+        }
+    }
+
+    // aggregate of the splay subtree of node with its pending reversal and lazy tag applied
+    [[nodiscard]] aggregate_t get_aggregate(vertex_t node) const {
+        aggregate_t result = nodes_m[node].aggregate;
+        if constexpr (HAS_EVERT) {
+            if (nodes_m[node].reversed) {
+                result = nodes_m[node].reversed_aggregate;
+            }
+        }
+        if constexpr (HAS_LAZY) {
+            Aggregate::template apply<Update>(result, nodes_m[node].lazy_data, get_size(node));
+        }
+        return result;
+    }
+
+    // aggregate of the splay subtree of node in reversed order, pending changes applied
+    [[nodiscard]] aggregate_t get_reversed_aggregate(vertex_t node) const {
+        aggregate_t result = nodes_m[node].reversed ? nodes_m[node].aggregate
+                                                    : nodes_m[node].reversed_aggregate;
+        if constexpr (HAS_LAZY) {
+            Aggregate::template apply<Update>(result, nodes_m[node].lazy_data, get_size(node));
+        }
+        return result;
+    }
 
-            left_subtree_min.result += nodes_m[left].lazy_data;
-            right_subtree_min.result += nodes_m[right].lazy_data;
+    void update(vertex_t node) {
+        vertex_t left = get_child<LEFT>(node);
+        vertex_t right = get_child<RIGHT>(node);
+
+        if constexpr (HAS_SIZE) {
+            nodes_m[node].subtree_size = 1 + get_size(left) + get_size(right);
+        }
 
-            subtree_min_t subtree_min = {node, nodes_m[node].data};
+        if constexpr (HAS_AGGREGATE) {
+            aggregate_t aggregate = Aggregate::make(node - 1, nodes_m[node].data);
+
+            if constexpr (HAS_EVERT) {
+                aggregate_t reversed = aggregate;
+                if (left) {
+                    reversed = Aggregate::combine(reversed, get_reversed_aggregate(left));
+                }
+                if (right) {
+                    reversed = Aggregate::combine(get_reversed_aggregate(right), reversed);
+                }
+                nodes_m[node].reversed_aggregate = reversed;
+            }
 
-            if (left_subtree_min.node && left_subtree_min.result < subtree_min.result) {
-                subtree_min = left_subtree_min;
+            if (left) {
+                aggregate = Aggregate::combine(get_aggregate(left), aggregate);
             }
 
-            if (right_subtree_min.node && right_subtree_min.result <= subtree_min.result) {
-                subtree_min = right_subtree_min;
+            if (right) {
+                aggregate = Aggregate::combine(aggregate, get_aggregate(right));
             }
 
-            nodes_m[node].subtree_min = subtree_min;
+            nodes_m[node].aggregate = aggregate;
         }
     }
 
     void lazy_update(vertex_t node) {
-        if (auto lazy_data = nodes_m[node].lazy_data; node && lazy_data) {
-            nodes_m[node].subtree_min.result += lazy_data;
-            nodes_m[node].data += lazy_data;
+        if constexpr (HAS_EVERT) {
+            auto &current = nodes_m[node];
+            if (current.reversed) {
+                std::swap(current.left, current.right);
+                if constexpr (HAS_AGGREGATE) {
+                    std::swap(current.aggregate, current.reversed_aggregate);
+                }
+
+                if (vertex_t left = current.left) {
+                    nodes_m[left].reversed = !nodes_m[left].reversed;
+                }
+
+                if (vertex_t right = current.right) {
+                    nodes_m[right].reversed = !nodes_m[right].reversed;
+                }
+
+                current.reversed = false;
+            }
+        }
+
+        if constexpr (HAS_LAZY) {
+            auto &current = nodes_m[node];
+            if (Update::is_identity(current.lazy_data)) {
+                return;
+            }
+
+            Update::apply(current.data, current.lazy_data, 1);
+            if constexpr (HAS_AGGREGATE) {
+                Aggregate::template apply<Update>(current.aggregate, current.lazy_data,
+                                                  get_size(node));
+                if constexpr (HAS_EVERT) {
+                    Aggregate::template apply<Update>(current.reversed_aggregate,
+                                                      current.lazy_data, get_size(node));
+                }
+            }
 
-            if (vertex_t left = get_child<LEFT>(node)) {
-                nodes_m[left].lazy_data += lazy_data;
+            if (vertex_t left = current.left) {
+                Update::compose(nodes_m[left].lazy_data, current.lazy_data);
             }
 
-            if (vertex_t right = get_child<RIGHT>(node)) {
-                nodes_m[right].lazy_data += lazy_data;
+            if (vertex_t right = current.right) {
+                Update::compose(nodes_m[right].lazy_data, current.lazy_data);
             }
 
-            nodes_m[node].lazy_data = DataType{};
+            current.lazy_data = Update::identity();
         }
     }
 
@@ -159,12 +470,32 @@ class link_cut {
     void splay(vertex_t node) {
         vertex_t parent;
         while ((parent = get_parent(node))) {
-            if (node == get_child<RIGHT>(parent)) {
+            if constexpr (HAS_EVERT) {
+                // pending reversals of further ancestors mirror the rotated part as a whole,
+                // so only the rotated nodes have to be pushed to read directions correctly
+                if (vertex_t parent_parent = get_parent(parent)) {
+                    lazy_update(parent_parent);
+                }
+                lazy_update(parent);
+                lazy_update(node);
+            }
+
+            if constexpr (HAS_SIMPLE_SPLAY) {
+                if (node == get_child<RIGHT>(parent)) {
+                    zig<RIGHT>(node);
+                } else {
+                    zig<LEFT>(node);
+                }
+            } else if (node == get_child<RIGHT>(parent)) {
                 splay_step<RIGHT>(node, parent);
             } else {
                 splay_step<LEFT>(node, parent);
             }
         }
+
+        if constexpr (HAS_EVERT) {
+            lazy_update(node);
+        }
     }
 
     void expose_remove_child(vertex_t node) {
@@ -206,15 +537,29 @@ class link_cut {
     }
 
     void cut(vertex_t node) {
-        vertex_t link_cut_parent = get_link_cut_parent(node);
-        expose(link_cut_parent);
-        get_link_cut_parent(node) = NO_VERTEX;
-        splay(node);
-        get_extra_parent(node) = NO_VERTEX;
+        if constexpr (HAS_EVERT) {
+            expose(node);
+            splay(node);
+            if (vertex_t child = get_child<LEFT>(node)) {
+                get_child<LEFT>(node) = NO_VERTEX;
+                get_parent(child) = NO_VERTEX;
+                get_extra_parent(child) = get_extra_parent(node);
+                get_extra_parent(node) = NO_VERTEX;
+                update(node);
+            }
+        } else {
+            vertex_t link_cut_parent = get_link_cut_parent(node);
+            expose(link_cut_parent);
+            get_link_cut_parent(node) = NO_VERTEX;
+            splay(node);
+            get_extra_parent(node) = NO_VERTEX;
+        }
     }
 
     void link(vertex_t node, vertex_t parent) {
-        get_link_cut_parent(node) = parent;
+        if constexpr (!HAS_EVERT) {
+            get_link_cut_parent(node) = parent;
+        }
 
         splay(node);
         get_extra_parent(node) = parent;
@@ -235,9 +580,18 @@ class link_cut {
 
     void init() {
         std::fill(nodes_m.begin(), nodes_m.end(), splay_node{});
-        nodes_m[0].subtree_size = 0;
-        for (vertex_t i = 1; i < nodes_m.size(); ++i) {
-            nodes_m[i].subtree_min.node = i;
+        if constexpr (HAS_SIZE) {
+            nodes_m[0].subtree_size = 0;
+        }
+        if constexpr (HAS_LAZY) {
+            for (auto &node : nodes_m) {
+                node.lazy_data = Update::identity();
+            }
+        }
+        if constexpr (HAS_AGGREGATE) {
+            for (vertex_t i = 1; i < nodes_m.size(); ++i) {
+                update(i);
+            }
         }
     }
 
@@ -251,18 +605,26 @@ class link_cut {
     }
 
     [[nodiscard]] vertex_t link_cut_root(vertex_t node) {
-        node = expose(++node);
-        vertex_t child;
-        while ((child = get_child<LEFT>(node))) {
-            node = child;
-        }
+        node = extreme<LEFT>(expose(++node));
         splay(node);
         return node - 1;
     }
 
     [[nodiscard]] std::optional<vertex_t> link_cut_parent(vertex_t node) {
-        vertex_t lc_parent = get_link_cut_parent(++node);
-        return lc_parent ? std::make_optional(lc_parent - 1) : std::nullopt;
+        if constexpr (HAS_EVERT) {
+            expose(++node);
+            splay(node);
+            vertex_t child = get_child<LEFT>(node);
+            if (!child) {
+                return std::nullopt;
+            }
+            node = extreme<RIGHT>(child);
+            splay(node);
+            return node - 1;
+        } else {
+            vertex_t lc_parent = get_link_cut_parent(++node);
+            return lc_parent ? std::make_optional(lc_parent - 1) : std::nullopt;
+        }
     }
 
     void link_cut_link(vertex_t node, vertex_t parent) {
@@ -270,6 +632,7 @@ class link_cut {
     }
 
     [[nodiscard]] std::size_t link_cut_depth(vertex_t node) {
+        static_assert((OPTIONS & TRACK_DEPTH) != 0, "link_cut_depth requires TRACK_DEPTH");
         return nodes_m[expose(++node)].subtree_size - 1;
     }
 
@@ -292,21 +655,295 @@ class link_cut {
         update(node);
     }
 
+    void link_cut_update_on_path(vertex_t node, const tag_t &tag) {
+        static_assert(HAS_LAZY, "link_cut_update_on_path requires an update policy");
+        Update::compose(nodes_m[expose(++node)].lazy_data, tag);
+    }
+
     void link_cut_add_on_path(vertex_t node, DataType data) {
-        nodes_m[expose(++node)].lazy_data += data;
+        link_cut_update_on_path(node, data);
     }
 
     [[nodiscard]] DataType link_cut_get(vertex_t node) {
         splay(++node);
-        return nodes_m[node].data + nodes_m[node].lazy_data;
+        DataType result = nodes_m[node].data;
+        if constexpr (HAS_LAZY) {
+            Update::apply(result, nodes_m[node].lazy_data, 1);
+        }
+        return result;
+    }
+
+    [[nodiscard]] aggregate_t link_cut_get_on_path(vertex_t node) {
+        static_assert(HAS_AGGREGATE, "link_cut_get_on_path requires an aggregate policy");
+        return get_aggregate(expose(++node));
     }
 
     [[nodiscard]] std::pair<vertex_t, DataType> link_cut_get_min_on_path(vertex_t node) {
+        auto aggregate = link_cut_get_on_path(node);
+        return {aggregate.node, aggregate.result};
+    }
+
+    struct operation {
+        operation_type type{};
+        vertex_t node{};
+        vertex_t parent{};
+        DataType data{};
+        tag_t tag{};
+    };
+
+    // vertex is filled by ROOT, data by GET, aggregate by GET_ON_PATH
+    struct operation_result {
+        vertex_t vertex{};
+        DataType data{};
+        aggregate_t aggregate{};
+    };
+
+    // Applies operations with the same results as applying them one by one. This is not a
+    // parallel batch-dynamic tree: operations are only split into groups that can reach vertices
+    // of disjoint trees, and a batch confined to one tree runs on a single thread. Trees touched by
+    // the batch are told apart by the splay roots of their root paths, read without splaying, and
+    // merged along batch links; then groups run in parallel, each in the original order. A batch
+    // with a path operation the policies lack, UPDATE_ON_PATH without an update or GET_ON_PATH
+    // without an aggregate, is rejected as a whole: nothing is applied and nullopt is returned.
+    [[nodiscard]] std::optional<std::vector<operation_result>>
+    link_cut_apply_batch(const std::vector<operation> &operations,
+                         std::size_t n_threads = parallel_utils::default_threads_count()) {
+
+        for (const auto &op : operations) {
+            if ((op.type == operation_type::UPDATE_ON_PATH && !HAS_LAZY) ||
+                (op.type == operation_type::GET_ON_PATH && !HAS_AGGREGATE)) {
+                return std::nullopt;
+            }
+        }
+
+        flows_utils::disjoint_sets groups(size());
+
+        // every node is walked up once per batch, the nodes on the way remember the tree found
+        std::vector<vertex_t> trees(nodes_m.size(), NO_VERTEX);
+        std::vector<vertex_t> way;
+        auto add_vertex = [&](vertex_t vertex) {
+            vertex_t node = vertex + 1;
+            while (!trees[node]) {
+                way.push_back(node);
+                vertex_t up = get_parent(node) ? get_parent(node) : get_extra_parent(node);
+                if (!up) {
+                    trees[node] = node;
+                    break;
+                }
+                node = up;
+            }
+            for (vertex_t passed : way) {
+                trees[passed] = trees[node];
+            }
+            way.clear();
+            groups.unite(trees[node] - 1, vertex);
+        };
+
+        for (const auto &op : operations) {
+            add_vertex(op.node);
+            if (op.type == operation_type::LINK) {
+                add_vertex(op.parent);
+                groups.unite(op.parent, op.node);
+            }
+        }
+
+        // operations are sorted by group into one array, larger groups first
+        std::vector<vertex_t> group_of(operations.size());
+        std::vector<std::size_t> offsets(size());
+        for (std::size_t i = 0; i < operations.size(); ++i) {
+            group_of[i] = groups.find(operations[i].node);
+            ++offsets[group_of[i]];
+        }
+        std::vector<vertex_t> leaders;
+        for (vertex_t vertex = 0; vertex < size(); ++vertex) {
+            if (offsets[vertex]) {
+                leaders.push_back(vertex);
+            }
+        }
+        std::sort(leaders.begin(), leaders.end(),
+                  [&](vertex_t lhs, vertex_t rhs) { return offsets[lhs] > offsets[rhs]; });
+        std::vector<std::size_t> group_begins(leaders.size() + 1);
+        for (std::size_t group = 0; group < leaders.size(); ++group) {
+            group_begins[group + 1] = group_begins[group] + offsets[leaders[group]];
+            offsets[leaders[group]] = group_begins[group];
+        }
+        std::vector<std::size_t> grouped_operations(operations.size());
+        for (std::size_t i = 0; i < operations.size(); ++i) {
+            grouped_operations[offsets[group_of[i]]++] = i;
+        }
+
+        auto apply = [this](const operation &op, operation_result &result) {
+            switch (op.type) {
+            case operation_type::LINK:
+                link_cut_link(op.node, op.parent);
+                break;
+            case operation_type::CUT:
+                link_cut_cut(op.node);
+                break;
+            case operation_type::ROOT:
+                result.vertex = link_cut_root(op.node);
+                break;
+            case operation_type::SET:
+                link_cut_set(op.node, op.data);
+                break;
+            case operation_type::ADD:
+                link_cut_add(op.node, op.data);
+                break;
+            case operation_type::GET:
+                result.data = link_cut_get(op.node);
+                break;
+            // the branches only compile with the policies, batches without them are rejected above
+            case operation_type::UPDATE_ON_PATH:
+                if constexpr (HAS_LAZY) {
+                    link_cut_update_on_path(op.node, op.tag);
+                }
+                break;
+            case operation_type::GET_ON_PATH:
+                if constexpr (HAS_AGGREGATE) {
+                    result.aggregate = link_cut_get_on_path(op.node);
+                }
+                break;
+            }
+        };
+
+        std::vector<operation_result> results(operations.size());
+        parallel_utils::parallel_for(leaders.size(), n_threads, [&](std::size_t group) {
+            for (std::size_t j = group_begins[group]; j < group_begins[group + 1]; ++j) {
+                apply(operations[grouped_operations[j]], results[grouped_operations[j]]);
+            }
+        });
+        return results;
+    }
+
+    // Operations below treat the forest as undirected and are available with EVERT only.
 
-        vertex_t path_root = expose(++node);
+    void link_cut_evert(vertex_t node) {
+        static_assert(HAS_EVERT, "link_cut_evert requires EVERT");
+        evert(++node);
+    }
+
+    [[nodiscard]] bool link_cut_connected(vertex_t node, vertex_t other) {
+        static_assert(HAS_EVERT, "link_cut_connected requires EVERT");
+        return node == other || link_cut_root(node) == link_cut_root(other);
+    }
+
+    // adds edge between vertices of different trees
+    void link_cut_connect(vertex_t node, vertex_t other) {
+        static_assert(HAS_EVERT, "link_cut_connect requires EVERT");
+        evert(++node);
+        link(node, ++other);
+    }
+
+    // removes existing edge between vertices
+    void link_cut_disconnect(vertex_t node, vertex_t other) {
+        static_assert(HAS_EVERT, "link_cut_disconnect requires EVERT");
+        evert(++node);
+        cut(++other);
+    }
+
+    void link_cut_update_on_path(vertex_t node, vertex_t other, const tag_t &tag) {
+        link_cut_evert(node);
+        link_cut_update_on_path(other, tag);
+    }
+
+    [[nodiscard]] aggregate_t link_cut_get_on_path(vertex_t node, vertex_t other) {
+        link_cut_evert(node);
+        return link_cut_get_on_path(other);
+    }
+
+    [[nodiscard]] std::pair<vertex_t, DataType> link_cut_get_min_on_path(vertex_t node,
+                                                                        vertex_t other) {
+        auto aggregate = link_cut_get_on_path(node, other);
+        return {aggregate.node, aggregate.result};
+    }
+};
+
+// Rooted forest with explicit parent pointers and the path operations of link_cut done by walking
+// up to the root. Operations cost O(depth), but with very small constants, which makes it a
+// baseline for dynamic-tree backends on shallow trees.
+template <typename DataType>
+class naive_tree {
+    static constexpr vertex_t NO_VERTEX = std::numeric_limits<vertex_t>::max();
+
+    std::vector<vertex_t> parents_m;
+    std::vector<DataType> values_m;
+
+  public:
+    explicit naive_tree(std::size_t n_vertices)
+        : parents_m(n_vertices, NO_VERTEX), values_m(n_vertices) {
+    }
+    naive_tree() = default;
+
+    [[nodiscard]] std::size_t size() const {
+        return parents_m.size();
+    }
+
+    void init() {
+        std::fill(parents_m.begin(), parents_m.end(), NO_VERTEX);
+        std::fill(values_m.begin(), values_m.end(), DataType{});
+    }
+
+    void reinit(std::size_t n_vertices) {
+        parents_m.resize(n_vertices);
+        values_m.resize(n_vertices);
+        init();
+    }
 
-        return {nodes_m[path_root].subtree_min.node - 1,
-                nodes_m[path_root].subtree_min.result + nodes_m[path_root].lazy_data};
+    void link_cut_cut(vertex_t node) {
+        parents_m[node] = NO_VERTEX;
+    }
+
+    void link_cut_link(vertex_t node, vertex_t parent) {
+        parents_m[node] = parent;
+    }
+
+    [[nodiscard]] vertex_t link_cut_root(vertex_t node) const {
+        while (parents_m[node] != NO_VERTEX) {
+            node = parents_m[node];
+        }
+        return node;
+    }
+
+    [[nodiscard]] std::optional<vertex_t> link_cut_parent(vertex_t node) const {
+        vertex_t parent = parents_m[node];
+        return parent != NO_VERTEX ? std::make_optional(parent) : std::nullopt;
+    }
+
+    [[nodiscard]] std::size_t link_cut_depth(vertex_t node) const {
+        std::size_t depth = 0;
+        for (; parents_m[node] != NO_VERTEX; node = parents_m[node]) {
+            ++depth;
+        }
+        return depth;
+    }
+
+    void link_cut_add(vertex_t node, DataType data) {
+        values_m[node] += data;
+    }
+
+    void link_cut_set(vertex_t node, DataType data) {
+        values_m[node] = data;
+    }
+
+    void link_cut_add_on_path(vertex_t node, DataType data) {
+        for (; node != NO_VERTEX; node = parents_m[node]) {
+            values_m[node] += data;
+        }
+    }
+
+    [[nodiscard]] DataType link_cut_get(vertex_t node) const {
+        return values_m[node];
+    }
+
+    // ties are resolved in favour of the deepest vertex, as in link_cut
+    [[nodiscard]] std::pair<vertex_t, DataType> link_cut_get_min_on_path(vertex_t node) const {
+        std::pair<vertex_t, DataType> result{node, values_m[node]};
+        for (node = parents_m[node]; node != NO_VERTEX; node = parents_m[node]) {
+            if (values_m[node] < result.second) {
+                result = {node, values_m[node]};
+            }
+        }
+        return result;
     }
 };
 
@@ -6,7 +6,15 @@
 #include <string>
 #include <vector>
 
+#include "auction.hpp"
+#include "dense_solvers.hpp"
 #include "dinics_solvers.hpp"
+#include "karger_stein.hpp"
+#include "min_cost_flow.hpp"
+#include "mincut_reductions.hpp"
+#include "push_relabel_solvers.hpp"
+#include "tree_packing.hpp"
+#include "unit_capacity_solvers.hpp"
 
 using solver_t = flows_coursework::flows_solver<int64_t>;
 using edges_set_t = std::vector<flows_coursework::capacity_edge<int64_t>>;
@@ -20,8 +28,89 @@ const std::map<std::string, std::function<std::unique_ptr<solver_t>()>> STRING_T
     {"edmonds", create_solver<flows_coursework::edmonds_solvers::edmonds_solver<int64_t>>},
     {"dinics", create_solver<flows_coursework::dinics_solvers::basic_dinics_solver<int64_t>>},
     {"linkcut", create_solver<flows_coursework::dinics_solvers::linkcut_dinics_solver<int64_t>>},
+    {"linkcut-simple-splay",
+     create_solver<flows_coursework::dinics_solvers::linkcut_dinics_solver<
+         int64_t, flows_coursework::dinics_solvers::simple_splay_dynamic_tree<int64_t>>>},
+    {"linkcut-naive",
+     create_solver<flows_coursework::dinics_solvers::linkcut_dinics_solver<
+         int64_t, flows_coursework::link_cut::naive_tree<int64_t>>>},
+    {"hybrid", create_solver<flows_coursework::dinics_solvers::hybrid_dinics_solver<int64_t>>},
+    {"mpm", create_solver<flows_coursework::dinics_solvers::mpm_dinics_solver<int64_t>>},
+    {"push-relabel-linkcut",
+     create_solver<
+         flows_coursework::push_relabel_solvers::dynamic_tree_push_relabel_solver<int64_t>>},
     {"scaled-dinics",
-     create_solver<flows_coursework::dinics_solvers::scaled_dinics_solver<int64_t>>}};
+     create_solver<flows_coursework::dinics_solvers::scaled_dinics_solver<int64_t>>},
+    {"unit",
+     create_solver<flows_coursework::unit_capacity_solvers::unit_capacity_solver<int64_t>>},
+    {"dense-dinics", create_solver<flows_coursework::dense_solvers::dense_dinics_solver<int64_t>>},
+    {"density", create_solver<flows_coursework::dense_solvers::density_aware_solver<int64_t>>}};
+
+using mincut_solver_t = std::function<std::vector<bool>(std::size_t, const edges_set_t &)>;
+
+const std::map<std::string, mincut_solver_t> STRING_TO_MINCUT_SOLVER{
+    {"stoer-wagner", flows_coursework::undirected_cuts::stoer_wagner_mincut<int64_t>},
+    {"kernel", flows_coursework::undirected_cuts::kernelized_mincut<int64_t>},
+    {"certificate", flows_coursework::undirected_cuts::certified_mincut<int64_t>},
+    {"tree-packing",
+     [](std::size_t n, const edges_set_t &data) {
+         return flows_coursework::undirected_cuts::tree_packing_mincut_solver<int64_t>().find_mincut(
+             n, data);
+     }},
+    {"matula",
+     [](std::size_t n, const edges_set_t &data) {
+         return flows_coursework::undirected_cuts::matula_mincut_approximator<int64_t>()
+             .approximate(n, data)
+             .cut;
+     }},
+    {"hao-orlin",
+     [](std::size_t n, const edges_set_t &data) {
+         auto directed = data;
+         for (const auto &edge : data) {
+             directed.emplace_back(edge.to, edge.from, edge.capacity);
+         }
+         return flows_coursework::push_relabel_solvers::hao_orlin_mincut_solver<int64_t>()
+             .find_mincut(n, directed);
+     }},
+    {"karger-stein", [](std::size_t n, const edges_set_t &data) {
+         return flows_coursework::undirected_cuts::karger_stein_mincut_solver<int64_t>().find_mincut(
+             n, data);
+     }}};
+
+using cost_edges_t = std::vector<flows_coursework::cost_edge<int64_t>>;
+
+const int64_t MAX_ASSIGNMENT_WEIGHT = 1'000'000;
+
+// heaviest assignment of n left and n right vertices as a min-cost flow, weights w becoming costs
+// MAX_ASSIGNMENT_WEIGHT - w, source and target edges costing nothing
+template <typename SolverType>
+int64_t assignment_by_flow(std::size_t n, const cost_edges_t &data) {
+    cost_edges_t network;
+    network.reserve(data.size() + 2 * n);
+    for (const auto &edge : data) {
+        network.emplace_back(edge.from, n + edge.to, 1, MAX_ASSIGNMENT_WEIGHT - edge.cost);
+    }
+    for (std::size_t v = 0; v < n; ++v) {
+        network.emplace_back(2 * n, v, 1, 0);
+        network.emplace_back(n + v, 2 * n + 1, 1, 0);
+    }
+    SolverType solver;
+    solver.solve(2 * n + 2, 2 * n, 2 * n + 1, network);
+    return static_cast<int64_t>(n) * MAX_ASSIGNMENT_WEIGHT - solver.cost();
+}
+
+const std::map<std::string, std::function<int64_t(std::size_t, const cost_edges_t &)>>
+    STRING_TO_ASSIGNMENT_SOLVER{
+        {"auction",
+         [](std::size_t n, const cost_edges_t &data) {
+             flows_coursework::assignment::auction_assignment_solver<int64_t> solver;
+             solver.solve(n, data);
+             return solver.weight();
+         }},
+        {"cost-scaling",
+         assignment_by_flow<flows_coursework::min_cost_flows::cost_scaling_solver<int64_t>>},
+        {"ssp", assignment_by_flow<
+                    flows_coursework::min_cost_flows::successive_shortest_paths_solver<int64_t>>}};
 
 static std::mt19937 generator{42}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables
 
@@ -36,12 +125,84 @@ const std::map<std::string, std::function<void(edges_set_t &, int &, int &, int
                                       if (v == u) {
                                           continue;
                                       }
-                                      int c = std::uniform_int_distribution<int64_t>(1, 1'000'000)(
-                                          generator);
+                                      int64_t c = std::uniform_int_distribution<int64_t>(
+                                          1, 1'000'000)(generator);
                                       data.emplace_back(u, v, c);
                                   }
                               }
                           }},
+                         {"random-sparse",
+                          [](edges_set_t &data, int &n, int &s, int &t) -> void {
+                              data.clear();
+                              s = 0;
+                              t = 1;
+                              for (int i = 0; i < 4 * n; ++i) {
+                                  int u = std::uniform_int_distribution<int>(0, n - 1)(generator);
+                                  int v = std::uniform_int_distribution<int>(0, n - 1)(generator);
+                                  int64_t c = std::uniform_int_distribution<int64_t>(1, 1'000'000)(
+                                      generator);
+                                  data.emplace_back(u, v, c);
+                              }
+                          }},
+                         {"random-connected",
+                          [](edges_set_t &data, int &n, int &s, int &t) -> void {
+                              data.clear();
+                              s = 0;
+                              t = 1;
+                              for (int v = 1; v < n; ++v) {
+                                  int u = std::uniform_int_distribution<int>(0, v - 1)(generator);
+                                  int64_t c = std::uniform_int_distribution<int64_t>(1, 1'000'000)(
+                                      generator);
+                                  data.emplace_back(u, v, c);
+                              }
+                              for (int i = 0; i < 3 * n; ++i) {
+                                  int u = std::uniform_int_distribution<int>(0, n - 1)(generator);
+                                  int v = std::uniform_int_distribution<int>(0, n - 1)(generator);
+                                  int64_t c = std::uniform_int_distribution<int64_t>(1, 1'000'000)(
+                                      generator);
+                                  data.emplace_back(u, v, c);
+                              }
+                          }},
+                         {"random-matching",
+                          [](edges_set_t &data, int &n, int &s, int &t) -> void {
+                              data.clear();
+                              s = 2 * n;
+                              t = 2 * n + 1;
+                              for (int u = 0; u < n; ++u) {
+                                  data.emplace_back(s, u, 1);
+                                  data.emplace_back(n + u, t, 1);
+                              }
+                              for (int i = 0; i < 4 * n; ++i) {
+                                  int u = std::uniform_int_distribution<int>(0, n - 1)(generator);
+                                  int v = std::uniform_int_distribution<int>(0, n - 1)(generator);
+                                  data.emplace_back(u, n + v, 1);
+                              }
+                              n = 2 * n + 2;
+                          }},
+                         {"deep-fan",
+                          [](edges_set_t &data, int &n, int &s, int &t) -> void {
+                              // a path of n edges to a hub with 4n unit paths of 2 to 5 edges
+                              // to the target, so every phase is deep and has n augmentations
+                              data.clear();
+                              s = 0;
+                              t = 1;
+                              for (int i = 0; i < n; ++i) {
+                                  data.emplace_back(i == 0 ? s : i + 1, i + 2, 4 * n);
+                              }
+                              int hub = n + 1;
+                              int next = n + 2;
+                              for (int length = 1; length <= 4; ++length) {
+                                  for (int i = 0; i < n; ++i) {
+                                      int current = hub;
+                                      for (int j = 0; j < length; ++j) {
+                                          data.emplace_back(current, next, 1);
+                                          current = next++;
+                                      }
+                                      data.emplace_back(current, t, 1);
+                                  }
+                              }
+                              n = next;
+                          }},
                          {"akc-hard",
                           [](edges_set_t &data, int &n, int &s, int &t) -> void {
                               data = flows_coursework::flows_utils::akc_test(n);
@@ -52,6 +213,128 @@ const std::map<std::string, std::function<void(edges_set_t &, int &, int &, int
 
                          }};
 
+using tree_t = flows_coursework::link_cut::link_cut<int64_t>;
+using flows_coursework::link_cut::operation_type;
+
+// the same operation as in link_cut_apply_batch, called directly
+static tree_t::operation_result apply_one(tree_t &tree, const tree_t::operation &op) {
+    tree_t::operation_result result;
+    switch (op.type) {
+    case operation_type::LINK:
+        tree.link_cut_link(op.node, op.parent);
+        break;
+    case operation_type::CUT:
+        tree.link_cut_cut(op.node);
+        break;
+    case operation_type::ROOT:
+        result.vertex = tree.link_cut_root(op.node);
+        break;
+    case operation_type::SET:
+        tree.link_cut_set(op.node, op.data);
+        break;
+    case operation_type::ADD:
+        tree.link_cut_add(op.node, op.data);
+        break;
+    case operation_type::GET:
+        result.data = tree.link_cut_get(op.node);
+        break;
+    case operation_type::UPDATE_ON_PATH:
+        tree.link_cut_update_on_path(op.node, op.tag);
+        break;
+    case operation_type::GET_ON_PATH:
+        result.aggregate = tree.link_cut_get_on_path(op.node);
+        break;
+    }
+    return result;
+}
+
+// operations on n vertices, after the scenarios of the link_cut unit tests
+const std::map<std::string, std::function<std::vector<tree_t::operation>(std::size_t)>>
+    STRING_TO_BATCH{
+        {"paths",
+         [](std::size_t n) {
+             // independent paths of 1000 vertices, each getting the same number of path updates
+             // and queries
+             std::size_t path_length = 1000;
+             std::vector<tree_t::operation> operations;
+             for (std::size_t i = 0; i < n; ++i) {
+                 if (i % path_length != 0) {
+                     operations.push_back({operation_type::LINK, i, i - 1});
+                 }
+             }
+             std::uniform_int_distribution<std::size_t> vertices(0, n - 1);
+             for (std::size_t j = 0; j < 4 * n; ++j) {
+                 std::size_t vertex = vertices(generator);
+                 int64_t value = std::uniform_int_distribution<int64_t>(-9, 9)(generator);
+                 operations.push_back({j % 2 ? operation_type::GET_ON_PATH
+                                             : operation_type::UPDATE_ON_PATH,
+                                       vertex, 0, 0, value});
+             }
+             return operations;
+         }},
+        {"big-path",
+         [](std::size_t n) {
+             // one path, as in "big path random test": a batch confined to a single tree
+             std::vector<tree_t::operation> operations;
+             for (std::size_t i = 1; i < n; ++i) {
+                 operations.push_back({operation_type::LINK, i, i - 1});
+             }
+             std::uniform_int_distribution<std::size_t> vertices(0, n - 1);
+             for (std::size_t j = 0; j < 4 * n; ++j) {
+                 std::size_t vertex = vertices(generator);
+                 int64_t value = std::uniform_int_distribution<int64_t>(-9, 9)(generator);
+                 operations.push_back({j % 2 ? operation_type::GET_ON_PATH
+                                             : operation_type::UPDATE_ON_PATH,
+                                       vertex, 0, 0, value});
+             }
+             return operations;
+         }},
+        {"random-forest", [](std::size_t n) {
+             // links, cuts, roots, adds and path operations on a random forest, as in "batch
+             // coincides with sequential application"
+             flows_coursework::link_cut::naive_tree<int64_t> forest(n);
+             std::vector<tree_t::operation> operations;
+             while (operations.size() < 4 * n) {
+                 tree_t::operation op;
+                 op.node = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+                 op.data = std::uniform_int_distribution<int64_t>(-9, 9)(generator);
+                 op.tag = op.data;
+                 switch (std::uniform_int_distribution<int>(0, 6)(generator)) {
+                 case 0:
+                 case 1:
+                     op.parent = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+                     if (forest.link_cut_parent(op.node).has_value() ||
+                         forest.link_cut_root(op.parent) == op.node) {
+                         continue;
+                     }
+                     op.type = operation_type::LINK;
+                     forest.link_cut_link(op.node, op.parent);
+                     break;
+                 case 2:
+                     if (!forest.link_cut_parent(op.node).has_value()) {
+                         continue;
+                     }
+                     op.type = operation_type::CUT;
+                     forest.link_cut_cut(op.node);
+                     break;
+                 case 3:
+                     op.type = operation_type::ROOT;
+                     break;
+                 case 4:
+                     op.type = operation_type::ADD;
+                     break;
+                 case 5:
+                     op.type = operation_type::UPDATE_ON_PATH;
+                     break;
+                 case 6:
+                     op.type = operation_type::GET_ON_PATH;
+                     break;
+                 }
+                 operations.push_back(op);
+             }
+             return operations;
+         }}};
+
 int main([[maybe_unused]] int argc, char *argv[]) {
     std::string mode = argv[1];
 
@@ -112,5 +395,119 @@ int main([[maybe_unused]] int argc, char *argv[]) {
         auto elapsed_ms =
             std::chrono::duration_cast<std::chrono::milliseconds>(finish_exec - start_exec);
         std::cout << elapsed_ms.count() << " milliseconds" << std::endl;
+
+    } else if (mode == "mincut") {
+        std::vector<flows_coursework::capacity_edge<int64_t>> data;
+
+        const auto &solver = STRING_TO_MINCUT_SOLVER.find(argv[2])->second;
+
+        int n = std::atoi(argv[4]);
+        int s;
+        int t;
+
+        STRING_TO_GENERATION.find(argv[3])->second(data, n, s, t);
+        auto start_exec = std::chrono::steady_clock::now();
+        auto cut = flows_coursework::undirected_cuts::cut_size(data, solver(n, data));
+        auto finish_exec = std::chrono::steady_clock::now();
+
+        auto elapsed_ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(finish_exec - start_exec);
+        std::cout << "cut " << cut << ", " << elapsed_ms.count() << " milliseconds" << std::endl;
+
+    } else if (mode == "assignment") {
+        // complete bipartite graph with weights in [0, MAX_ASSIGNMENT_WEIGHT]
+        const auto &solver = STRING_TO_ASSIGNMENT_SOLVER.find(argv[2])->second;
+        std::size_t n = std::atoi(argv[3]);
+
+        cost_edges_t data;
+        data.reserve(n * n);
+        for (std::size_t u = 0; u < n; ++u) {
+            for (std::size_t v = 0; v < n; ++v) {
+                data.emplace_back(u, v, 1,
+                                  std::uniform_int_distribution<int64_t>(
+                                      0, MAX_ASSIGNMENT_WEIGHT)(generator));
+            }
+        }
+        auto start_exec = std::chrono::steady_clock::now();
+        auto weight = solver(n, data);
+        auto finish_exec = std::chrono::steady_clock::now();
+
+        auto elapsed_ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(finish_exec - start_exec);
+        std::cout << "weight " << weight << ", " << elapsed_ms.count() << " milliseconds"
+                  << std::endl;
+
+    } else if (mode == "min-cost") {
+        // n vertices and m random edges with capacities and costs in [1, 100], from 0 to 1
+        std::string solver = argv[2];
+        int n = std::atoi(argv[3]);
+        int m = std::atoi(argv[4]);
+
+        cost_edges_t data;
+        for (int i = 0; i < m; ++i) {
+            int u = std::uniform_int_distribution<int>(0, n - 1)(generator);
+            int v = std::uniform_int_distribution<int>(0, n - 1)(generator);
+            int64_t c = std::uniform_int_distribution<int64_t>(1, 100)(generator);
+            int64_t cost = std::uniform_int_distribution<int64_t>(1, 100)(generator);
+            data.emplace_back(u, v, c, cost);
+        }
+        auto start_exec = std::chrono::steady_clock::now();
+        int64_t value = 0;
+        int64_t cost = 0;
+        if (solver == "cost-scaling") {
+            flows_coursework::min_cost_flows::cost_scaling_solver<int64_t> flow;
+            flow.solve(n, 0, 1, data);
+            value = flow.flow_value();
+            cost = flow.cost();
+        } else if (solver == "ssp") {
+            flows_coursework::min_cost_flows::successive_shortest_paths_solver<int64_t> flow;
+            flow.solve(n, 0, 1, data);
+            value = flow.flow_value();
+            cost = flow.cost();
+        } else {
+            edges_set_t network(data.begin(), data.end());
+            value = flows_coursework::flows_utils::flow_size(
+                0, network,
+                flows_coursework::dinics_solvers::basic_dinics_solver<int64_t>().solve(n, 0, 1,
+                                                                                      network));
+        }
+        auto finish_exec = std::chrono::steady_clock::now();
+
+        auto elapsed_ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(finish_exec - start_exec);
+        std::cout << "flow " << value << ", cost " << cost << ", " << elapsed_ms.count()
+                  << " milliseconds" << std::endl;
+
+    } else if (mode == "linkcut-batch") {
+        using tree_t = flows_coursework::link_cut::link_cut<int64_t>;
+
+        std::size_t n_threads = std::atoi(argv[3]);
+        std::size_t n = std::atoi(argv[4]);
+        auto operations = STRING_TO_BATCH.find(argv[2])->second(n);
+
+        {
+            tree_t tree(n);
+            auto start_exec = std::chrono::steady_clock::now();
+            for (const auto &op : operations) {
+                apply_one(tree, op);
+            }
+            auto finish_exec = std::chrono::steady_clock::now();
+
+            auto elapsed_ms =
+                std::chrono::duration_cast<std::chrono::milliseconds>(finish_exec - start_exec);
+            std::cout << "one by one, " << operations.size() << " operations: "
+                      << elapsed_ms.count() << " milliseconds" << std::endl;
+        }
+        for (std::size_t threads : {std::size_t{1}, n_threads}) {
+            tree_t tree(n);
+            auto start_exec = std::chrono::steady_clock::now();
+            auto results = tree.link_cut_apply_batch(operations, threads);
+            auto finish_exec = std::chrono::steady_clock::now();
+
+            auto elapsed_ms =
+                std::chrono::duration_cast<std::chrono::milliseconds>(finish_exec - start_exec);
+            std::cout << threads << " threads, " << results->size() << " operations: "
+                      << elapsed_ms.count() << " milliseconds" << std::endl;
+        }
     }
 }
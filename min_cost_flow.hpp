@@ -0,0 +1,428 @@
+#ifndef FLOWS_COURSEWORK_MIN_COST_FLOW_HPP
+#define FLOWS_COURSEWORK_MIN_COST_FLOW_HPP
+
+#include "dinics_solvers.hpp"
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace min_cost_flows {
+
+// Successive shortest paths: every augmentation follows a cheapest residual path from the source
+// to the target, found by Dijkstra on costs reduced by vertex potentials. Potentials are the
+// distances of the previous search, which keeps reduced costs of residual arcs non-negative; with
+// negative edge costs the first ones come from Bellman-Ford. Negative cycles are not supported.
+// Costs live next to the residual graph, indexed like its edges, and all buffers are reused
+// between searches.
+template <typename DataType>
+class successive_shortest_paths_solver {
+    static constexpr DataType INF = std::numeric_limits<DataType>::max();
+
+    using heap_item_t = std::pair<DataType, vertex_t>;
+
+    flows_utils::flow_graph<DataType> graph_m;
+    std::vector<DataType> costs_m;
+    std::vector<DataType> potentials_m;
+    std::vector<DataType> distances_m;
+    // edge a vertex was reached by in the last search
+    std::vector<edge_index_t> reached_by_m;
+    std::vector<heap_item_t> heap_m;
+    DataType flow_value_m{};
+    DataType cost_m{};
+
+    [[nodiscard]] DataType residual_cost(vertex_t u, std::size_t i) const {
+        const auto &edge = graph_m.get_edge_by_vertex(u, i);
+        DataType cost = costs_m[graph_m.get_edge_index(u, i)];
+        return u == edge.from ? cost : -cost;
+    }
+
+    // distances from the source over arcs of positive residual capacity
+    void bellman_ford() {
+        distances_m.assign(graph_m.size(), INF);
+        distances_m[graph_m.source()] = DataType{};
+        for (std::size_t round = 0; round < graph_m.size(); ++round) {
+            bool changed = false;
+            for (vertex_t u = 0; u < graph_m.size(); ++u) {
+                if (distances_m[u] == INF) {
+                    continue;
+                }
+                for (std::size_t i = 0; i < graph_m.degree(u); ++i) {
+                    const auto &edge = graph_m.get_edge_by_vertex(u, i);
+                    vertex_t other = graph_m.adjacent(u, edge);
+                    if (graph_m.may_push(u, edge) > DataType{} &&
+                        distances_m[u] + residual_cost(u, i) < distances_m[other]) {
+                        distances_m[other] = distances_m[u] + residual_cost(u, i);
+                        changed = true;
+                    }
+                }
+            }
+            if (!changed) {
+                break;
+            }
+        }
+        update_potentials();
+    }
+
+    // vertices left unreached stay unreachable, their potentials do not matter
+    void update_potentials() {
+        for (vertex_t u = 0; u < graph_m.size(); ++u) {
+            if (distances_m[u] != INF) {
+                potentials_m[u] += distances_m[u];
+            }
+        }
+    }
+
+    bool dijkstra() {
+        distances_m.assign(graph_m.size(), INF);
+        distances_m[graph_m.source()] = DataType{};
+        heap_m.clear();
+        heap_m.emplace_back(DataType{}, graph_m.source());
+        while (!heap_m.empty()) {
+            std::pop_heap(heap_m.begin(), heap_m.end(), std::greater<>());
+            auto [distance, u] = heap_m.back();
+            heap_m.pop_back();
+            if (distance != distances_m[u]) {
+                continue;
+            }
+            for (std::size_t i = 0; i < graph_m.degree(u); ++i) {
+                const auto &edge = graph_m.get_edge_by_vertex(u, i);
+                if (graph_m.may_push(u, edge) == DataType{}) {
+                    continue;
+                }
+                vertex_t other = graph_m.adjacent(u, edge);
+                DataType reduced = residual_cost(u, i) + potentials_m[u] - potentials_m[other];
+                if (distance + reduced < distances_m[other]) {
+                    distances_m[other] = distance + reduced;
+                    reached_by_m[other] = graph_m.get_edge_index(u, i);
+                    heap_m.emplace_back(distances_m[other], other);
+                    std::push_heap(heap_m.begin(), heap_m.end(), std::greater<>());
+                }
+            }
+        }
+        update_potentials();
+        return distances_m[graph_m.target()] != INF;
+    }
+
+    // pushes at most limit along the path found by the last search
+    void augment(DataType limit) {
+        DataType amount = limit;
+        for (vertex_t v = graph_m.target(); v != graph_m.source();) {
+            const auto &edge = graph_m.get_edge_by_index(reached_by_m[v]);
+            v = graph_m.adjacent(v, edge);
+            amount = std::min(amount, graph_m.may_push(v, edge));
+        }
+        for (vertex_t v = graph_m.target(); v != graph_m.source();) {
+            edge_index_t index = reached_by_m[v];
+            auto &edge = graph_m.get_edge_by_index(index);
+            v = graph_m.adjacent(v, edge);
+            graph_m.push(v, edge, amount);
+            cost_m += (v == edge.from ? costs_m[index] : -costs_m[index]) * amount;
+        }
+        flow_value_m += amount;
+    }
+
+  public:
+    // Cheapest flow of value target_flow from source to target, or of the maximum value if less
+    // can be sent. Returns the flow of every edge.
+    std::vector<DataType> solve(std::size_t graph_size, vertex_t source, vertex_t target,
+                                const std::vector<cost_edge<DataType>> &edges,
+                                DataType target_flow = INF) {
+        graph_m = flows_utils::flow_graph<DataType>(
+            graph_size, source, target,
+            std::vector<capacity_edge<DataType>>(edges.begin(), edges.end()));
+        costs_m.resize(edges.size());
+        for (edge_index_t i = 0; i < edges.size(); ++i) {
+            costs_m[i] = edges[i].cost;
+        }
+        potentials_m.assign(graph_size, DataType{});
+        reached_by_m.assign(graph_size, 0);
+        flow_value_m = DataType{};
+        cost_m = DataType{};
+
+        if (std::any_of(edges.begin(), edges.end(), [](const auto &edge) {
+                return edge.cost < DataType{} && edge.capacity > DataType{};
+            })) {
+            bellman_ford();
+        }
+        while (flow_value_m < target_flow && source != target && dijkstra()) {
+            augment(target_flow - flow_value_m);
+        }
+
+        return flows_utils::flow_vector(graph_m);
+    }
+
+    // value of the last solved flow
+    [[nodiscard]] DataType flow_value() const {
+        return flow_value_m;
+    }
+
+    // cost of the last solved flow
+    [[nodiscard]] DataType cost() const {
+        return cost_m;
+    }
+};
+
+// Goldberg's cost scaling. Dinic's first sends the flow value, through an extra source edge when
+// a target value is given, and the cheapest circulation of the residual network is then found by
+// push-relabel refinements: costs are multiplied by n + 1 so that 1-optimality is optimality, and
+// every refinement divides epsilon by ALPHA. Negative cycles are canceled like any other. Prices
+// are recomputed from distances to deficits after every n relabels, a push first relabels its
+// head if that could only send the flow back, and edges whose reduced cost exceeds 2n epsilon
+// keep their flow in every optimal solution, so they are fixed and skipped from then on.
+template <typename DataType>
+class cost_scaling_solver {
+    static constexpr DataType INF = std::numeric_limits<DataType>::max();
+    static constexpr DataType ALPHA = 8;
+
+    using heap_item_t = std::pair<DataType, vertex_t>;
+
+    flows_utils::flow_graph<DataType> graph_m;
+    std::vector<DataType> costs_m;
+    std::vector<bool> fixed_m;
+    std::vector<DataType> prices_m;
+    std::vector<DataType> excesses_m;
+    std::vector<std::size_t> current_edges_m;
+    std::deque<vertex_t> active_m;
+    std::vector<DataType> distances_m;
+    std::vector<heap_item_t> heap_m;
+    DataType epsilon_m{};
+    std::size_t relabels_m = 0;
+    DataType flow_value_m{};
+    DataType cost_m{};
+
+    [[nodiscard]] DataType reduced_cost(vertex_t u, const flows_utils::flow_edge<DataType> &edge,
+                                        DataType cost) const {
+        return (u == edge.from ? cost : -cost) + prices_m[u] - prices_m[graph_m.adjacent(u, edge)];
+    }
+
+    [[nodiscard]] bool usable(vertex_t u, std::size_t i) const {
+        return !fixed_m[graph_m.get_edge_index(u, i)] &&
+               graph_m.may_push(u, graph_m.get_edge_by_vertex(u, i)) > DataType{};
+    }
+
+    [[nodiscard]] bool admissible(vertex_t u, std::size_t i) const {
+        edge_index_t index = graph_m.get_edge_index(u, i);
+        return usable(u, i) &&
+               reduced_cost(u, graph_m.get_edge_by_index(index), costs_m[index]) < DataType{};
+    }
+
+    void push(vertex_t u, std::size_t i, DataType amount) {
+        auto &edge = graph_m.get_edge_by_vertex(u, i);
+        vertex_t other = graph_m.adjacent(u, edge);
+        graph_m.push(u, edge, amount);
+        excesses_m[u] -= amount;
+        if (excesses_m[other] <= DataType{} && excesses_m[other] + amount > DataType{}) {
+            active_m.push_back(other);
+        }
+        excesses_m[other] += amount;
+    }
+
+    // lowers the price just enough to make the cheapest usable edge admissible
+    void relabel(vertex_t u) {
+        DataType highest = -INF;
+        for (std::size_t i = 0; i < graph_m.degree(u); ++i) {
+            if (usable(u, i)) {
+                edge_index_t index = graph_m.get_edge_index(u, i);
+                const auto &edge = graph_m.get_edge_by_index(index);
+                highest = std::max(highest, prices_m[u] - reduced_cost(u, edge, costs_m[index]));
+            }
+        }
+        prices_m[u] = highest == -INF ? prices_m[u] - epsilon_m : highest - epsilon_m;
+        current_edges_m[u] = 0;
+        ++relabels_m;
+    }
+
+    // skips edges that are not admissible, they stay so until the vertex is relabeled
+    bool find_admissible(vertex_t u) {
+        while (current_edges_m[u] < graph_m.degree(u) && !admissible(u, current_edges_m[u])) {
+            ++current_edges_m[u];
+        }
+        return current_edges_m[u] < graph_m.degree(u);
+    }
+
+    void discharge(vertex_t u) {
+        while (excesses_m[u] > DataType{}) {
+            if (!find_admissible(u)) {
+                relabel(u);
+                if (relabels_m % graph_m.size() == 0) {
+                    update_prices();
+                }
+                continue;
+            }
+            std::size_t i = current_edges_m[u];
+            vertex_t other = graph_m.adjacent(u, graph_m.get_edge_by_vertex(u, i));
+            if (excesses_m[other] >= DataType{} && !find_admissible(other)) {
+                relabel(other);
+                if (!admissible(u, i)) {
+                    continue;
+                }
+            }
+            DataType may_push = graph_m.may_push(u, graph_m.get_edge_by_vertex(u, i));
+            push(u, i, std::min(excesses_m[u], may_push));
+        }
+    }
+
+    // Prices drop by epsilon times the distance to the nearest deficit, where a usable edge of
+    // reduced cost c is floor(c / epsilon) + 1 long; vertices that reach no deficit drop by more
+    // than any distance. This keeps epsilon-optimality and makes edges on shortest ways admissible.
+    void update_prices() {
+        const std::size_t n = graph_m.size();
+        distances_m.assign(n, INF);
+        heap_m.clear();
+        for (vertex_t v = 0; v < n; ++v) {
+            if (excesses_m[v] < DataType{}) {
+                distances_m[v] = DataType{};
+                heap_m.emplace_back(DataType{}, v);
+            }
+        }
+        std::make_heap(heap_m.begin(), heap_m.end(), std::greater<>());
+        DataType farthest{};
+        while (!heap_m.empty()) {
+            std::pop_heap(heap_m.begin(), heap_m.end(), std::greater<>());
+            auto [distance, v] = heap_m.back();
+            heap_m.pop_back();
+            if (distance != distances_m[v]) {
+                continue;
+            }
+            farthest = distance;
+            for (std::size_t i = 0; i < graph_m.degree(v); ++i) {
+                edge_index_t index = graph_m.get_edge_index(v, i);
+                const auto &edge = graph_m.get_edge_by_index(index);
+                vertex_t u = graph_m.adjacent(v, edge);
+                if (fixed_m[index] || graph_m.may_push(u, edge) == DataType{}) {
+                    continue;
+                }
+                DataType length = (reduced_cost(u, edge, costs_m[index]) + epsilon_m) / epsilon_m;
+                if (distance + length < distances_m[u]) {
+                    distances_m[u] = distance + length;
+                    heap_m.emplace_back(distances_m[u], u);
+                    std::push_heap(heap_m.begin(), heap_m.end(), std::greater<>());
+                }
+            }
+        }
+        for (vertex_t v = 0; v < n; ++v) {
+            prices_m[v] -= epsilon_m * (distances_m[v] == INF ? farthest + 1 : distances_m[v]);
+        }
+        current_edges_m.assign(n, 0);
+    }
+
+    // turns the 2 * epsilon-optimal flow into an epsilon-optimal one
+    void refine() {
+        for (edge_index_t index = 0; index < graph_m.n_edges(); ++index) {
+            auto &edge = graph_m.get_edge_by_index(index);
+            if (fixed_m[index]) {
+                continue;
+            }
+            DataType cost = reduced_cost(edge.from, edge, costs_m[index]);
+            vertex_t tail = cost < DataType{} ? edge.from : edge.to;
+            if (cost != DataType{} && graph_m.may_push(tail, edge) > DataType{}) {
+                DataType amount = graph_m.may_push(tail, edge);
+                graph_m.push(tail, edge, amount);
+                excesses_m[tail] -= amount;
+                excesses_m[graph_m.adjacent(tail, edge)] += amount;
+            }
+        }
+
+        active_m.clear();
+        for (vertex_t v = 0; v < graph_m.size(); ++v) {
+            if (excesses_m[v] > DataType{}) {
+                active_m.push_back(v);
+            }
+        }
+        update_prices();
+        while (!active_m.empty()) {
+            vertex_t v = active_m.front();
+            active_m.pop_front();
+            discharge(v);
+        }
+    }
+
+    void fix_edges() {
+        const DataType threshold = 2 * static_cast<DataType>(graph_m.size()) * epsilon_m;
+        for (edge_index_t index = 0; index < graph_m.n_edges(); ++index) {
+            const auto &edge = graph_m.get_edge_by_index(index);
+            DataType cost = reduced_cost(edge.from, edge, costs_m[index]);
+            if (cost > threshold || cost < -threshold) {
+                fixed_m[index] = true;
+            }
+        }
+    }
+
+  public:
+    // Cheapest flow of value target_flow from source to target, or of the maximum value if less
+    // can be sent. Returns the flow of every edge.
+    std::vector<DataType> solve(std::size_t graph_size, vertex_t source, vertex_t target,
+                                const std::vector<cost_edge<DataType>> &edges,
+                                DataType target_flow = INF) {
+        std::vector<capacity_edge<DataType>> network(edges.begin(), edges.end());
+        std::vector<DataType> flow(edges.size());
+        flow_value_m = DataType{};
+        if (source != target && target_flow != INF) {
+            network.emplace_back(graph_size, source, target_flow);
+            flow = dinics_solvers::basic_dinics_solver<DataType>().solve(graph_size + 1, graph_size,
+                                                                        target, network);
+            flow_value_m = flow.back();
+            network.pop_back();
+            flow.pop_back();
+        } else if (source != target) {
+            flow = dinics_solvers::basic_dinics_solver<DataType>().solve(graph_size, source, target,
+                                                                        network);
+            flow_value_m = flows_utils::flow_size(source, network, flow);
+        }
+
+        graph_m = flows_utils::flow_graph<DataType>(graph_size, source, target, network);
+        costs_m.resize(edges.size());
+        epsilon_m = 1;
+        for (edge_index_t i = 0; i < edges.size(); ++i) {
+            graph_m.get_edge_by_index(i).flow_value = flow[i];
+            costs_m[i] = edges[i].cost * static_cast<DataType>(graph_size + 1);
+            epsilon_m = std::max({epsilon_m, costs_m[i], -costs_m[i]});
+        }
+        // a flow graph cannot send flow back over a loop, so loops are fixed, full if negative
+        fixed_m.assign(edges.size(), false);
+        for (edge_index_t i = 0; i < edges.size(); ++i) {
+            if (edges[i].from == edges[i].to) {
+                fixed_m[i] = true;
+                graph_m.get_edge_by_index(i).flow_value =
+                    edges[i].cost < DataType{} ? edges[i].capacity : DataType{};
+            }
+        }
+        prices_m.assign(graph_size, DataType{});
+        excesses_m.assign(graph_size, DataType{});
+        current_edges_m.assign(graph_size, 0);
+        relabels_m = 0;
+
+        while (epsilon_m > 1) {
+            epsilon_m = std::max<DataType>(1, epsilon_m / ALPHA);
+            refine();
+            fix_edges();
+        }
+
+        flow = flows_utils::flow_vector(graph_m);
+        cost_m = DataType{};
+        for (edge_index_t i = 0; i < edges.size(); ++i) {
+            cost_m += flow[i] * edges[i].cost;
+        }
+        return flow;
+    }
+
+    // value of the last solved flow
+    [[nodiscard]] DataType flow_value() const {
+        return flow_value_m;
+    }
+
+    // cost of the last solved flow
+    [[nodiscard]] DataType cost() const {
+        return cost_m;
+    }
+};
+
+} // namespace min_cost_flows
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_MIN_COST_FLOW_HPP
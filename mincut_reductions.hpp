@@ -0,0 +1,404 @@
+#ifndef FLOWS_COURSEWORK_MINCUT_REDUCTIONS_HPP
+#define FLOWS_COURSEWORK_MINCUT_REDUCTIONS_HPP
+
+#include "stoer_wagner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace undirected_cuts {
+
+// Graph with contracted vertices whose minimum cut, together with upper_bound_cut, gives the
+// minimum cut of the original graph.
+template <typename DataType>
+struct mincut_kernel {
+    std::size_t n_vertices{};
+    std::vector<capacity_edge<DataType>> edges;
+    // kernel vertex of every original vertex
+    std::vector<vertex_t> labels;
+    // best cut seen while contracting, always a single super-vertex against the rest
+    DataType upper_bound{};
+    std::vector<bool> upper_bound_cut;
+};
+
+// Cut of one side with its weight, an upper bound for the minimum cut
+template <typename DataType>
+struct approximate_mincut {
+    DataType upper_bound{};
+    std::vector<bool> cut;
+};
+
+namespace detail {
+
+// adjacency of super-vertices, indexed by the roots of their sets, and their weighted degrees
+template <typename DataType>
+void build_contracted_graph(flows_utils::disjoint_sets &super_vertices,
+                            const std::vector<capacity_edge<DataType>> &edges,
+                            std::vector<std::vector<std::pair<vertex_t, DataType>>> &graph,
+                            std::vector<DataType> &degrees) {
+    std::size_t n_vertices = super_vertices.size();
+    std::vector<vertex_t> roots(n_vertices);
+    for (vertex_t v = 0; v < n_vertices; ++v) {
+        roots[v] = super_vertices.find(v);
+    }
+
+    graph.assign(n_vertices, {});
+    degrees.assign(n_vertices, DataType{});
+    for (const auto &edge : flows_utils::contracted_edges(n_vertices, edges, roots)) {
+        graph[edge.from].emplace_back(edge.to, edge.capacity);
+        graph[edge.to].emplace_back(edge.from, edge.capacity);
+        degrees[edge.from] += edge.capacity;
+        degrees[edge.to] += edge.capacity;
+    }
+}
+
+} // namespace detail
+
+// Matula's (2 + epsilon)-approximation. Every round scans super-vertices in maximum adjacency
+// order and contracts an edge to y once the weight r(y) between y and the scanned vertices reaches
+// upper_bound / (2 + epsilon): such edges are crossed only by cuts heavier than the threshold. The
+// upper bound is the lightest super-vertex seen. A round contracts at least the last edge scanned,
+// and in practice a constant fraction of vertices, each costing O(m log n).
+template <typename DataType>
+class matula_mincut_approximator {
+    double epsilon_m;
+    flows_utils::disjoint_sets super_vertices_m;
+    std::vector<std::vector<std::pair<vertex_t, DataType>>> graph_m;
+
+    // builds compacted adjacency of super-vertices, returns the lightest of them and their number
+    std::pair<vertex_t, std::size_t> build_graph(const std::vector<capacity_edge<DataType>> &edges,
+                                                 std::vector<DataType> &degrees) {
+        detail::build_contracted_graph(super_vertices_m, edges, graph_m, degrees);
+
+        std::size_t n_vertices = super_vertices_m.size();
+        vertex_t lightest = n_vertices;
+        for (vertex_t u = 0; u < n_vertices; ++u) {
+            if (super_vertices_m.find(u) == u &&
+                (lightest == n_vertices || degrees[u] < degrees[lightest])) {
+                lightest = u;
+            }
+        }
+        return {lightest, super_vertices_m.sets_count()};
+    }
+
+  public:
+    explicit matula_mincut_approximator(double epsilon = 0.1) : epsilon_m(epsilon) {
+    }
+
+    [[nodiscard]] approximate_mincut<DataType>
+    approximate(std::size_t n_vertices, const std::vector<capacity_edge<DataType>> &edges) {
+        approximate_mincut<DataType> result{std::numeric_limits<DataType>::max(),
+                                            std::vector<bool>(n_vertices)};
+        if (n_vertices < 2) {
+            result.upper_bound = DataType{};
+            return result;
+        }
+
+        super_vertices_m.reinit(n_vertices);
+        std::vector<DataType> degrees;
+        flows_utils::indexed_heap<DataType> queue_weights(n_vertices);
+
+        for (auto [lightest, n_super_vertices] = build_graph(edges, degrees);
+             n_super_vertices > 1; std::tie(lightest, n_super_vertices) = build_graph(edges, degrees)) {
+            if (degrees[lightest] < result.upper_bound) {
+                result.upper_bound = degrees[lightest];
+                for (vertex_t u = 0; u < n_vertices; ++u) {
+                    result.cut[u] = super_vertices_m.find(u) == lightest;
+                }
+            }
+            if (n_super_vertices == 2 || result.upper_bound == DataType{}) {
+                break;
+            }
+
+            auto threshold = static_cast<DataType>(
+                std::ceil(static_cast<double>(result.upper_bound) / (2 + epsilon_m)));
+            queue_weights.reinit(n_vertices);
+            for (vertex_t u = 0; u < n_vertices; ++u) {
+                if (super_vertices_m.find(u) == u) {
+                    queue_weights.push(u, DataType{});
+                }
+            }
+
+            std::vector<std::pair<vertex_t, vertex_t>> contracted;
+            while (!queue_weights.empty()) {
+                vertex_t current = queue_weights.top();
+                queue_weights.pop();
+
+                for (const auto &[other, weight] : graph_m[current]) {
+                    if (queue_weights.contains(other)) {
+                        DataType attached = queue_weights.key(other) + weight;
+                        queue_weights.update(other, attached);
+                        if (attached >= threshold) {
+                            contracted.emplace_back(current, other);
+                        }
+                    }
+                }
+            }
+
+            for (const auto &[u, v] : contracted) {
+                super_vertices_m.unite(u, v);
+            }
+        }
+        return result;
+    }
+};
+
+// Padberg-Rinaldi contraction. Let u, v be adjacent with common neighbours w, d the weighted degree
+// and c the weight. Either some minimum cut does not separate u and v, or it is found among cuts of
+// single super-vertices, if
+//   1. c(uv) >= upper_bound,
+//   2. 2 c(uv) >= min(d(u), d(v)),
+//   3. 2 (c(uv) + c(uw)) >= d(u) and 2 (c(uv) + c(vw)) >= d(v) for some w,
+//   4. c(uv) + sum of min(c(uw), c(vw)) >= upper_bound.
+// Rules 1 and 4 bound every cut separating u and v, so all such pairs are contracted at once.
+// Rules 2 and 3 depend on degrees, so in a round they only contract pairs of untouched vertices.
+// Rounds repeat until no rule fires.
+template <typename DataType>
+class padberg_rinaldi_kernelizer {
+    static constexpr std::size_t SCAN_BUDGET_FACTOR = 4;
+
+    flows_utils::disjoint_sets super_vertices_m;
+    std::vector<std::vector<std::pair<vertex_t, DataType>>> graph_m;
+    std::vector<DataType> degrees_m;
+    std::vector<bool> touched_m;
+
+    void update_upper_bound(std::size_t n_vertices, mincut_kernel<DataType> &kernel) {
+        vertex_t best = n_vertices;
+        for (vertex_t u = 0; u < n_vertices; ++u) {
+            if (super_vertices_m.find(u) == u && degrees_m[u] < kernel.upper_bound) {
+                kernel.upper_bound = degrees_m[u];
+                best = u;
+            }
+        }
+        if (best != n_vertices) {
+            for (vertex_t u = 0; u < n_vertices; ++u) {
+                kernel.upper_bound_cut[u] = super_vertices_m.find(u) == best;
+            }
+        }
+    }
+
+    // one round of contractions, returns whether any rule fired
+    bool contract_round(std::size_t n_vertices, DataType upper_bound) {
+        bool contracted = false;
+        touched_m.assign(n_vertices, false);
+        // weights of edges to u, or zero for vertices not adjacent to u
+        std::vector<DataType> weights_to_u(n_vertices);
+        std::vector<bool> adjacent_to_u(n_vertices);
+
+        // neighbour lists scanned for rules 3 and 4, which cost O(m sqrt(m)) on dense graphs
+        std::size_t budget = 0;
+        for (const auto &adjacent : graph_m) {
+            budget += SCAN_BUDGET_FACTOR * adjacent.size();
+        }
+        const std::vector<std::pair<vertex_t, DataType>> no_neighbours;
+
+        auto contract = [&](vertex_t u, vertex_t v) {
+            contracted |= super_vertices_m.unite(u, v);
+            touched_m[u] = touched_m[v] = true;
+        };
+
+        // lists are those of super-vertices at the start of the round, so merges made in the round
+        // only strengthen rules 1, 3 and 4
+        for (vertex_t u = 0; u < n_vertices; ++u) {
+            for (const auto &[v, weight] : graph_m[u]) {
+                weights_to_u[v] = weight;
+                adjacent_to_u[v] = true;
+            }
+
+            for (const auto &[v, weight] : graph_m[u]) {
+                // every pair is checked once, scanning the shorter list
+                if (graph_m[v].size() > graph_m[u].size() ||
+                    (graph_m[v].size() == graph_m[u].size() && v > u)) {
+                    continue;
+                }
+
+                if (weight >= upper_bound) {
+                    contract(u, v);
+                    continue;
+                }
+
+                DataType common{};
+                bool triangle = false;
+                if (budget < graph_m[v].size()) {
+                    // rules 3 and 4 are skipped for the rest of the round
+                    budget = 0;
+                } else {
+                    budget -= graph_m[v].size();
+                }
+                for (const auto &[w, weight_vw] : budget ? graph_m[v] : no_neighbours) {
+                    if (adjacent_to_u[w]) {
+                        common += std::min(weights_to_u[w], weight_vw);
+                        triangle |= 2 * (weight + weights_to_u[w]) >= degrees_m[u] &&
+                                    2 * (weight + weight_vw) >= degrees_m[v];
+                    }
+                }
+
+                if (weight + common >= upper_bound) {
+                    contract(u, v);
+                } else if ((2 * weight >= std::min(degrees_m[u], degrees_m[v]) || triangle) &&
+                           !touched_m[u] && !touched_m[v]) {
+                    contract(u, v);
+                }
+            }
+
+            for (const auto &[v, weight] : graph_m[u]) {
+                weights_to_u[v] = DataType{};
+                adjacent_to_u[v] = false;
+            }
+        }
+        return contracted;
+    }
+
+  public:
+    [[nodiscard]] mincut_kernel<DataType>
+    kernelize(std::size_t n_vertices, const std::vector<capacity_edge<DataType>> &edges) {
+        return kernelize(n_vertices, edges,
+                         {std::numeric_limits<DataType>::max(), std::vector<bool>(n_vertices)});
+    }
+
+    // starts from a known cut, e.g. the one found by matula_mincut_approximator
+    [[nodiscard]] mincut_kernel<DataType> kernelize(std::size_t n_vertices,
+                                                    const std::vector<capacity_edge<DataType>> &edges,
+                                                    approximate_mincut<DataType> bound) {
+        mincut_kernel<DataType> kernel;
+        kernel.upper_bound = bound.upper_bound;
+        kernel.upper_bound_cut = std::move(bound.cut);
+
+        super_vertices_m.reinit(n_vertices);
+        while (super_vertices_m.sets_count() > 1) {
+            detail::build_contracted_graph(super_vertices_m, edges, graph_m, degrees_m);
+            update_upper_bound(n_vertices, kernel);
+            if (super_vertices_m.sets_count() == 2 ||
+                !contract_round(n_vertices, kernel.upper_bound)) {
+                break;
+            }
+        }
+
+        kernel.n_vertices = super_vertices_m.sets_count();
+        kernel.labels = super_vertices_m.labels();
+        kernel.edges = flows_utils::contracted_edges(kernel.n_vertices, edges, kernel.labels);
+        return kernel;
+    }
+};
+
+template <typename DataType>
+[[nodiscard]] std::vector<DataType> weighted_degrees(std::size_t n_vertices,
+                                                     const std::vector<capacity_edge<DataType>> &edges) {
+    std::vector<DataType> degrees(n_vertices);
+    for (const auto &edge : edges) {
+        if (edge.from != edge.to) {
+            degrees[edge.from] += edge.capacity;
+            degrees[edge.to] += edge.capacity;
+        }
+    }
+    return degrees;
+}
+
+// Nagamochi-Ibaraki certificate: edges scanned in maximum adjacency order, an edge to y keeps
+// min(c, k - r(y)) where r(y) is the weight between y and the vertices scanned before. Every cut
+// weighs at least the smaller of its original weight and k, and the kept edges weigh O(kn).
+template <typename DataType>
+[[nodiscard]] std::vector<capacity_edge<DataType>>
+sparse_certificate(std::size_t n_vertices, const std::vector<capacity_edge<DataType>> &edges,
+                   DataType k) {
+    std::vector<std::vector<edge_index_t>> graph(n_vertices);
+    for (edge_index_t i = 0; i < edges.size(); ++i) {
+        if (edges[i].from != edges[i].to) {
+            graph[edges[i].from].push_back(i);
+            graph[edges[i].to].push_back(i);
+        }
+    }
+
+    flows_utils::indexed_heap<DataType> queue_weights(n_vertices);
+    for (vertex_t v = 0; v < n_vertices; ++v) {
+        queue_weights.push(v, DataType{});
+    }
+
+    std::vector<capacity_edge<DataType>> certificate;
+    while (!queue_weights.empty()) {
+        vertex_t current = queue_weights.top();
+        queue_weights.pop();
+
+        for (edge_index_t edge_index : graph[current]) {
+            const auto &edge = edges[edge_index];
+            vertex_t other = edge.from + edge.to - current;
+            if (!queue_weights.contains(other)) {
+                continue;
+            }
+
+            DataType attached = queue_weights.key(other);
+            if (attached < k) {
+                certificate.emplace_back(current, other, std::min(edge.capacity, k - attached));
+            }
+            queue_weights.update(other, attached + edge.capacity);
+        }
+    }
+    return certificate;
+}
+
+// Minimum cut found by Stoer-Wagner on the certificate for k equal to the minimum weighted degree.
+// A certificate cut lighter than k is a cut of the same weight in the graph, otherwise the
+// lightest vertex is a minimum cut.
+template <typename DataType>
+[[nodiscard]] std::vector<bool> certified_mincut(std::size_t n_vertices,
+                                                 const std::vector<capacity_edge<DataType>> &edges) {
+    if (n_vertices < 2) {
+        return std::vector<bool>(n_vertices);
+    }
+
+    auto degrees = weighted_degrees(n_vertices, edges);
+    vertex_t lightest = std::min_element(degrees.begin(), degrees.end()) - degrees.begin();
+
+    auto certificate = sparse_certificate(n_vertices, edges, degrees[lightest]);
+    auto cut = stoer_wagner_mincut(n_vertices, certificate);
+    if (cut_size(certificate, cut) < degrees[lightest]) {
+        return cut;
+    }
+
+    std::vector<bool> result(n_vertices);
+    result[lightest] = true;
+    return result;
+}
+
+template <typename T>
+T global_mincut_size_certified_dinics(std::size_t n, const std::vector<capacity_edge<T>> &data) {
+    auto degrees = weighted_degrees(n, data);
+    T k = *std::min_element(degrees.begin(), degrees.end());
+    return std::min(k, global_mincut_size_dinics(n, sparse_certificate(n, data, k)));
+}
+
+// Minimum cut found by Stoer-Wagner on the Padberg-Rinaldi kernel, starting from Matula's bound
+template <typename DataType>
+[[nodiscard]] std::vector<bool> kernelized_mincut(std::size_t n_vertices,
+                                                  const std::vector<capacity_edge<DataType>> &edges) {
+    if (n_vertices < 2) {
+        return std::vector<bool>(n_vertices);
+    }
+
+    auto kernel = padberg_rinaldi_kernelizer<DataType>().kernelize(
+        n_vertices, edges, matula_mincut_approximator<DataType>().approximate(n_vertices, edges));
+    if (kernel.n_vertices < 2) {
+        return kernel.upper_bound_cut;
+    }
+
+    auto kernel_cut = stoer_wagner_mincut(kernel.n_vertices, kernel.edges);
+    if (cut_size(kernel.edges, kernel_cut) >= kernel.upper_bound) {
+        return kernel.upper_bound_cut;
+    }
+
+    std::vector<bool> result(n_vertices);
+    for (vertex_t u = 0; u < n_vertices; ++u) {
+        result[u] = kernel_cut[kernel.labels[u]];
+    }
+    return result;
+}
+
+} // namespace undirected_cuts
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_MINCUT_REDUCTIONS_HPP
@@ -0,0 +1,51 @@
+#ifndef FLOWS_COURSEWORK_PARALLEL_UTILS_HPP
+#define FLOWS_COURSEWORK_PARALLEL_UTILS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace parallel_utils {
+
+[[nodiscard]] inline std::size_t default_threads_count() {
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+// Calls function(i) for every i < n_tasks on up to n_threads threads, the calling thread included.
+// Tasks are handed out one by one in increasing order.
+template <typename Function>
+void parallel_for(std::size_t n_tasks, std::size_t n_threads, const Function &function) {
+    n_threads = std::min(n_threads, n_tasks);
+    if (n_threads <= 1) {
+        for (std::size_t i = 0; i < n_tasks; ++i) {
+            function(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next_task{0};
+    auto worker = [&]() {
+        for (std::size_t i; (i = next_task.fetch_add(1)) < n_tasks;) {
+            function(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads - 1);
+    for (std::size_t i = 0; i + 1 < n_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace parallel_utils
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_PARALLEL_UTILS_HPP
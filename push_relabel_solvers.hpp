@@ -0,0 +1,662 @@
+#ifndef FLOWS_COURSEWORK_PUSH_RELABEL_SOLVERS_HPP
+#define FLOWS_COURSEWORK_PUSH_RELABEL_SOLVERS_HPP
+
+#include "dinics_solvers.hpp"
+#include "link_cut.hpp"
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace push_relabel_solvers {
+
+// Goldberg-Tarjan push-relabel: current arcs form a forest kept in a dynamic tree whose values are
+// residual capacities of tree arcs, so excess travels along a whole tree path in one send.
+// Only tree roots hold excess. A link that would make a tree larger than n^2 / m vertices is
+// replaced by a plain push, which keeps the O(nm log(n^2 / m)) bound; subtree sizes live in a
+// second dynamic tree, as a link adds the size of the child on the root path of its parent. Labels
+// are recomputed from exact residual distances after every n relabels.
+template <typename DataType,
+          typename DynamicTree = dinics_solvers::default_dynamic_tree<DataType>>
+class dynamic_tree_push_relabel_solver final : public flows_solver<DataType> {
+    static constexpr DataType INF = std::numeric_limits<DataType>::max();
+
+    using sizes_tree_t = link_cut::link_cut<std::ptrdiff_t, link_cut::no_aggregate<std::ptrdiff_t>,
+                                            link_cut::add_update<std::ptrdiff_t>>;
+
+    flows_utils::flow_graph<DataType> graph_m;
+    DynamicTree tree_m;
+    sizes_tree_t sizes_m;
+    std::size_t max_tree_size_m = 1;
+    std::vector<std::size_t> labels_m;
+    std::vector<std::size_t> current_edges_m;
+    std::vector<DataType> excesses_m;
+    std::deque<vertex_t> active_m;
+    std::deque<vertex_t> queue_m;
+    std::size_t relabels_m = 0;
+
+    [[nodiscard]] flows_utils::flow_edge<DataType> &current_edge(vertex_t vertex) {
+        return graph_m.get_edge_by_vertex(vertex, current_edges_m[vertex]);
+    }
+
+    void add_excess(vertex_t vertex, DataType amount) {
+        if (excesses_m[vertex] == DataType{} && vertex != graph_m.source() &&
+            vertex != graph_m.target()) {
+            active_m.push_back(vertex);
+        }
+        excesses_m[vertex] += amount;
+    }
+
+    // labels vertices by residual distance to root, starting from base
+    void label_by_distance(vertex_t root, std::size_t base, std::size_t unlabeled) {
+        labels_m[root] = base;
+        queue_m.assign(1, root);
+        while (!queue_m.empty()) {
+            vertex_t current = queue_m.front();
+            queue_m.pop_front();
+
+            for (std::size_t i = 0; i < graph_m.degree(current); ++i) {
+                const auto &edge = graph_m.get_edge_by_vertex(current, i);
+                vertex_t other = graph_m.adjacent(current, edge);
+                if (labels_m[other] == unlabeled && graph_m.may_push(other, edge)) {
+                    labels_m[other] = labels_m[current] + 1;
+                    queue_m.push_back(other);
+                }
+            }
+        }
+    }
+
+    // moves flow of every tree arc to the graph, leaving single vertices
+    void cut_all() {
+        for (vertex_t i = 0; i < graph_m.size(); ++i) {
+            if (tree_m.link_cut_parent(i).has_value()) {
+                cut(i);
+            }
+        }
+    }
+
+    void global_relabel() {
+        cut_all();
+
+        const std::size_t unlabeled = 2 * graph_m.size();
+        labels_m.assign(graph_m.size(), unlabeled);
+        labels_m[graph_m.source()] = graph_m.size();
+        label_by_distance(graph_m.target(), 0, unlabeled);
+        label_by_distance(graph_m.source(), graph_m.size(), unlabeled);
+
+        current_edges_m.assign(graph_m.size(), 0);
+        relabels_m = 0;
+    }
+
+    [[nodiscard]] std::size_t tree_size(vertex_t vertex) {
+        return static_cast<std::size_t>(sizes_m.link_cut_get(tree_m.link_cut_root(vertex)));
+    }
+
+    void link(vertex_t vertex, vertex_t parent, DataType capacity) {
+        tree_m.link_cut_link(vertex, parent);
+        tree_m.link_cut_set(vertex, capacity);
+        sizes_m.link_cut_link(vertex, parent);
+        sizes_m.link_cut_add_on_path(parent, sizes_m.link_cut_get(vertex));
+    }
+
+    // moves flow accumulated on the tree arc of vertex to the graph and makes vertex a root
+    void cut(vertex_t vertex) {
+        auto &edge = current_edge(vertex);
+        graph_m.push(vertex, edge, graph_m.may_push(vertex, edge) - tree_m.link_cut_get(vertex));
+        tree_m.link_cut_cut(vertex);
+        tree_m.link_cut_set(vertex, INF);
+        sizes_m.link_cut_add_on_path(graph_m.adjacent(vertex, edge), -sizes_m.link_cut_get(vertex));
+        sizes_m.link_cut_cut(vertex);
+    }
+
+    void send(vertex_t vertex) {
+        while (excesses_m[vertex] > DataType{} && tree_m.link_cut_parent(vertex).has_value()) {
+            vertex_t root = tree_m.link_cut_root(vertex);
+            DataType amount =
+                std::min(excesses_m[vertex], tree_m.link_cut_get_min_on_path(vertex).second);
+
+            tree_m.link_cut_add_on_path(vertex, -amount);
+            tree_m.link_cut_set(root, INF);
+            excesses_m[vertex] -= amount;
+            add_excess(root, amount);
+
+            for (auto min_entry = tree_m.link_cut_get_min_on_path(vertex);
+                 min_entry.second == DataType{};
+                 min_entry = tree_m.link_cut_get_min_on_path(vertex)) {
+                cut(min_entry.first);
+            }
+        }
+    }
+
+    void relabel(vertex_t vertex) {
+        std::size_t min_label = std::numeric_limits<std::size_t>::max();
+
+        for (std::size_t i = 0; i < graph_m.degree(vertex); ++i) {
+            const auto &edge = graph_m.get_edge_by_vertex(vertex, i);
+            vertex_t other = graph_m.adjacent(vertex, edge);
+            if (tree_m.link_cut_parent(other) == vertex) {
+                cut(other);
+            }
+        }
+
+        for (std::size_t i = 0; i < graph_m.degree(vertex); ++i) {
+            const auto &edge = graph_m.get_edge_by_vertex(vertex, i);
+            if (graph_m.may_push(vertex, edge)) {
+                min_label = std::min(min_label, labels_m[graph_m.adjacent(vertex, edge)]);
+            }
+        }
+
+        labels_m[vertex] = min_label + 1;
+        current_edges_m[vertex] = 0;
+        ++relabels_m;
+    }
+
+    void discharge(vertex_t vertex) {
+        while (excesses_m[vertex] > DataType{}) {
+            if (current_edges_m[vertex] == graph_m.degree(vertex)) {
+                relabel(vertex);
+                continue;
+            }
+
+            const auto &edge = current_edge(vertex);
+            vertex_t other = graph_m.adjacent(vertex, edge);
+            DataType may_push = graph_m.may_push(vertex, edge);
+
+            if (may_push && labels_m[vertex] == labels_m[other] + 1) {
+                // vertex is a root here, as only roots keep excess
+                if (tree_size(vertex) + tree_size(other) <= max_tree_size_m) {
+                    link(vertex, other, may_push);
+                    send(vertex);
+                } else {
+                    DataType amount = std::min(excesses_m[vertex], may_push);
+                    graph_m.push(vertex, current_edge(vertex), amount);
+                    excesses_m[vertex] -= amount;
+                    add_excess(other, amount);
+                    send(other);
+                }
+            } else {
+                ++current_edges_m[vertex];
+            }
+        }
+    }
+
+  public:
+    std::vector<DataType> solve(std::size_t graph_size, vertex_t source, vertex_t target,
+                                const std::vector<capacity_edge<DataType>> &edges) override {
+
+        graph_m = flows_utils::flow_graph(graph_size, source, target, edges);
+        tree_m.reinit(graph_size);
+        sizes_m.reinit(graph_size);
+        for (vertex_t i = 0; i < graph_size; ++i) {
+            tree_m.link_cut_set(i, INF);
+            sizes_m.link_cut_set(i, 1);
+        }
+        max_tree_size_m = graph_size * graph_size / std::max<std::size_t>(edges.size(), 1);
+        current_edges_m.assign(graph_size, 0);
+        excesses_m.assign(graph_size, DataType{});
+        active_m.clear();
+
+        for (std::size_t i = 0; i < graph_m.degree(source); ++i) {
+            auto &edge = graph_m.get_edge_by_vertex(source, i);
+            if (DataType may_push = graph_m.may_push(source, edge)) {
+                graph_m.push(source, edge, may_push);
+                add_excess(graph_m.adjacent(source, edge), may_push);
+            }
+        }
+
+        global_relabel();
+
+        while (!active_m.empty()) {
+            vertex_t vertex = active_m.front();
+            active_m.pop_front();
+            discharge(vertex);
+            if (relabels_m >= graph_size) {
+                global_relabel();
+            }
+        }
+
+        cut_all();
+
+        return flows_utils::flow_vector(graph_m);
+    }
+};
+
+// Hao-Orlin directed global minimum cut: one push-relabel run finds the lightest cut with vertex 0
+// on the source side. Sinks are taken in order of labels and join the sources once their cut is
+// known. A relabel that would leave a gap, or a vertex without residual arcs to awake vertices,
+// puts the affected vertices to sleep as a new dormant set; sets wake up in reverse order once
+// every awake vertex has become a source. The cut of a sink separates sleeping vertices from awake
+// ones. Active vertices are discharged highest label first, and labels are recomputed from
+// residual distances to the sink after every 8n relabels. A second run on reversed edges covers
+// cuts with vertex 0 on the sink side.
+template <typename DataType>
+class hao_orlin_mincut_solver {
+    static constexpr std::size_t AWAKE = std::numeric_limits<std::size_t>::max();
+
+    flows_utils::flow_graph<DataType> graph_m;
+    std::vector<std::size_t> labels_m;
+    std::vector<std::size_t> current_edges_m;
+    std::vector<DataType> excesses_m;
+    // index of the dormant set of a vertex, set 0 holds the sources
+    std::vector<std::size_t> dormant_m;
+    std::vector<std::vector<vertex_t>> dormant_sets_m;
+    // awake vertices of every label in doubly linked lists, graph size marks the end
+    std::vector<vertex_t> bucket_heads_m;
+    std::vector<vertex_t> bucket_next_m;
+    std::vector<vertex_t> bucket_prev_m;
+    std::vector<std::size_t> label_counts_m;
+    std::size_t n_awake_m = 0;
+    // bounds on labels of awake vertices
+    std::size_t lowest_label_m = 0;
+    std::size_t highest_label_m = 0;
+    // active vertices by label at the time they became active, the highest label goes first
+    std::vector<std::vector<vertex_t>> active_m;
+    std::size_t highest_active_m = 0;
+    std::deque<vertex_t> queue_m;
+    std::size_t relabels_m = 0;
+    vertex_t sink_m = 0;
+
+    void insert_awake(vertex_t vertex) {
+        std::size_t label = labels_m[vertex];
+        if (label >= bucket_heads_m.size()) {
+            bucket_heads_m.resize(label + 1, graph_m.size());
+            label_counts_m.resize(label + 1);
+        }
+        if (n_awake_m == 0) {
+            lowest_label_m = label;
+            highest_label_m = label;
+        }
+        lowest_label_m = std::min(lowest_label_m, label);
+        highest_label_m = std::max(highest_label_m, label);
+
+        bucket_prev_m[vertex] = graph_m.size();
+        bucket_next_m[vertex] = bucket_heads_m[label];
+        if (bucket_heads_m[label] != graph_m.size()) {
+            bucket_prev_m[bucket_heads_m[label]] = vertex;
+        }
+        bucket_heads_m[label] = vertex;
+        ++label_counts_m[label];
+        ++n_awake_m;
+    }
+
+    void erase_awake(vertex_t vertex) {
+        std::size_t label = labels_m[vertex];
+        if (bucket_prev_m[vertex] != graph_m.size()) {
+            bucket_next_m[bucket_prev_m[vertex]] = bucket_next_m[vertex];
+        } else {
+            bucket_heads_m[label] = bucket_next_m[vertex];
+        }
+        if (bucket_next_m[vertex] != graph_m.size()) {
+            bucket_prev_m[bucket_next_m[vertex]] = bucket_prev_m[vertex];
+        }
+        --label_counts_m[label];
+        --n_awake_m;
+    }
+
+    void activate(vertex_t vertex) {
+        if (labels_m[vertex] >= active_m.size()) {
+            active_m.resize(labels_m[vertex] + 1);
+        }
+        active_m[labels_m[vertex]].push_back(vertex);
+        highest_active_m = std::max(highest_active_m, labels_m[vertex]);
+    }
+
+    // highest active vertex or the graph size if there is none
+    [[nodiscard]] vertex_t pop_active() {
+        for (;; --highest_active_m) {
+            if (!active_m[highest_active_m].empty()) {
+                vertex_t vertex = active_m[highest_active_m].back();
+                active_m[highest_active_m].pop_back();
+                return vertex;
+            }
+            if (highest_active_m == 0) {
+                return graph_m.size();
+            }
+        }
+    }
+
+    void add_excess(vertex_t vertex, DataType amount) {
+        if (excesses_m[vertex] <= DataType{} && awake(vertex) && vertex != sink_m) {
+            activate(vertex);
+        }
+        excesses_m[vertex] += amount;
+    }
+
+    void push(vertex_t vertex, flows_utils::flow_edge<DataType> &edge, DataType amount) {
+        graph_m.push(vertex, edge, amount);
+        excesses_m[vertex] -= amount;
+        add_excess(graph_m.adjacent(vertex, edge), amount);
+    }
+
+    // puts vertex into the last dormant set
+    void sleep(vertex_t vertex) {
+        erase_awake(vertex);
+        dormant_m[vertex] = dormant_sets_m.size() - 1;
+        dormant_sets_m.back().push_back(vertex);
+    }
+
+    void make_source(vertex_t vertex) {
+        if (awake(vertex)) {
+            erase_awake(vertex);
+        }
+        dormant_m[vertex] = 0;
+        dormant_sets_m[0].push_back(vertex);
+        labels_m[vertex] = graph_m.size();
+        for (std::size_t i = 0; i < graph_m.degree(vertex); ++i) {
+            auto &edge = graph_m.get_edge_by_vertex(vertex, i);
+            DataType may_push = graph_m.may_push(vertex, edge);
+            if (may_push > DataType{} && dormant_m[graph_m.adjacent(vertex, edge)] != 0) {
+                push(vertex, edge, may_push);
+            }
+        }
+    }
+
+    void wake_last_set() {
+        auto woken = std::move(dormant_sets_m.back());
+        dormant_sets_m.pop_back();
+        for (vertex_t vertex : woken) {
+            dormant_m[vertex] = AWAKE;
+            insert_awake(vertex);
+            if (excesses_m[vertex] > DataType{}) {
+                activate(vertex);
+            }
+        }
+    }
+
+    // the sink is an awake vertex with the lowest label
+    void choose_sink() {
+        while (label_counts_m[lowest_label_m] == 0) {
+            ++lowest_label_m;
+        }
+        sink_m = bucket_heads_m[lowest_label_m];
+    }
+
+    // labels awake vertices by residual distance to the sink, the ones that cannot reach it fall
+    // asleep as one set
+    void global_relabel() {
+        const std::size_t unlabeled = std::numeric_limits<std::size_t>::max();
+        for (vertex_t vertex = 0; vertex < graph_m.size(); ++vertex) {
+            if (awake(vertex)) {
+                erase_awake(vertex);
+                labels_m[vertex] = unlabeled;
+                current_edges_m[vertex] = 0;
+            }
+        }
+
+        labels_m[sink_m] = 0;
+        queue_m.assign(1, sink_m);
+        while (!queue_m.empty()) {
+            vertex_t current = queue_m.front();
+            queue_m.pop_front();
+            insert_awake(current);
+
+            for (std::size_t i = 0; i < graph_m.degree(current); ++i) {
+                const auto &edge = graph_m.get_edge_by_vertex(current, i);
+                vertex_t other = graph_m.adjacent(current, edge);
+                if (awake(other) && labels_m[other] == unlabeled &&
+                    graph_m.may_push(other, edge) > DataType{}) {
+                    labels_m[other] = labels_m[current] + 1;
+                    queue_m.push_back(other);
+                }
+            }
+        }
+
+        bool set_started = false;
+        for (vertex_t vertex = 0; vertex < graph_m.size(); ++vertex) {
+            if (awake(vertex) && labels_m[vertex] == unlabeled) {
+                if (!set_started) {
+                    dormant_sets_m.emplace_back();
+                    set_started = true;
+                }
+                // one label for the whole set keeps it valid inside
+                labels_m[vertex] = 0;
+                insert_awake(vertex);
+                sleep(vertex);
+            }
+        }
+        relabels_m = 0;
+    }
+
+    void relabel(vertex_t vertex) {
+        ++relabels_m;
+        if (label_counts_m[labels_m[vertex]] == 1) {
+            // vertex and every awake vertex above it are cut off from the sink
+            std::size_t gap = labels_m[vertex];
+            dormant_sets_m.emplace_back();
+            for (std::size_t label = gap; label <= highest_label_m; ++label) {
+                while (bucket_heads_m[label] != graph_m.size()) {
+                    sleep(bucket_heads_m[label]);
+                }
+            }
+            highest_label_m = gap - 1;
+            return;
+        }
+
+        std::size_t min_label = std::numeric_limits<std::size_t>::max();
+        for (std::size_t i = 0; i < graph_m.degree(vertex); ++i) {
+            const auto &edge = graph_m.get_edge_by_vertex(vertex, i);
+            vertex_t other = graph_m.adjacent(vertex, edge);
+            if (graph_m.may_push(vertex, edge) > DataType{} && awake(other)) {
+                min_label = std::min(min_label, labels_m[other]);
+            }
+        }
+        if (min_label == std::numeric_limits<std::size_t>::max()) {
+            dormant_sets_m.emplace_back();
+            sleep(vertex);
+            return;
+        }
+
+        erase_awake(vertex);
+        labels_m[vertex] = min_label + 1;
+        insert_awake(vertex);
+        current_edges_m[vertex] = 0;
+    }
+
+    void discharge(vertex_t vertex) {
+        while (excesses_m[vertex] > DataType{} && awake(vertex)) {
+            if (current_edges_m[vertex] == graph_m.degree(vertex)) {
+                relabel(vertex);
+                continue;
+            }
+
+            auto &edge = graph_m.get_edge_by_vertex(vertex, current_edges_m[vertex]);
+            vertex_t other = graph_m.adjacent(vertex, edge);
+            DataType may_push = graph_m.may_push(vertex, edge);
+
+            if (may_push > DataType{} && awake(other) && labels_m[vertex] == labels_m[other] + 1) {
+                push(vertex, edge, std::min(may_push, excesses_m[vertex]));
+            } else {
+                ++current_edges_m[vertex];
+            }
+        }
+    }
+
+    // lightest cut with vertex 0 on the true side
+    [[nodiscard]] std::pair<DataType, std::vector<bool>>
+    source_side_mincut(std::size_t n_vertices, const std::vector<capacity_edge<DataType>> &edges) {
+        std::pair<DataType, std::vector<bool>> best{std::numeric_limits<DataType>::max(), {}};
+        run(n_vertices, edges, [&]() {
+            if (excess(sink()) < best.first) {
+                best.first = excess(sink());
+                best.second.resize(n_vertices);
+                for (vertex_t vertex = 0; vertex < n_vertices; ++vertex) {
+                    best.second[vertex] = !awake(vertex);
+                }
+            }
+        });
+        return best;
+    }
+
+    void start(std::size_t n_vertices, const std::vector<capacity_edge<DataType>> &edges) {
+        graph_m = flows_utils::flow_graph(n_vertices, 0, 0, edges);
+        labels_m.assign(n_vertices, 0);
+        current_edges_m.assign(n_vertices, 0);
+        excesses_m.assign(n_vertices, DataType{});
+        dormant_m.assign(n_vertices, AWAKE);
+        dormant_sets_m.assign(1, {});
+        bucket_heads_m.assign(n_vertices + 1, n_vertices);
+        bucket_next_m.assign(n_vertices, n_vertices);
+        bucket_prev_m.assign(n_vertices, n_vertices);
+        label_counts_m.assign(n_vertices + 1, 0);
+        n_awake_m = 0;
+        for (vertex_t vertex = 0; vertex < n_vertices; ++vertex) {
+            insert_awake(vertex);
+        }
+        active_m.assign(n_vertices + 1, {});
+        highest_active_m = 0;
+        relabels_m = 0;
+
+        // no sink yet, so every vertex that gets excess becomes active
+        sink_m = n_vertices;
+    }
+
+    // discharges active vertices until no excess can reach the sink
+    void saturate_sink() {
+        const std::size_t n_vertices = graph_m.size();
+        for (vertex_t vertex = pop_active(); vertex != n_vertices; vertex = pop_active()) {
+            if (vertex != sink_m) {
+                discharge(vertex);
+            }
+            // rarer than in the flow solver, gaps already put cut off vertices to sleep
+            if (relabels_m >= 8 * n_vertices) {
+                global_relabel();
+            }
+        }
+    }
+
+  public:
+    // One run with vertex 0 as the first source. on_sink() is called for every sink once its flow
+    // is done, before the sink joins the sources. The cut of the sink is then excess(sink()): no
+    // residual arc leaves the sleeping vertices, so edges of the cut are saturated, edges back
+    // carry nothing, and all the flow over the cut has reached the sink.
+    template <typename Callback>
+    void run(std::size_t n_vertices, const std::vector<capacity_edge<DataType>> &edges,
+             Callback &&on_sink) {
+        start(n_vertices, edges);
+        make_source(0);
+        choose_sink();
+
+        for (std::size_t n_sources = 1; n_sources < n_vertices; ++n_sources) {
+            saturate_sink();
+            on_sink();
+
+            make_source(sink_m);
+            if (n_sources + 1 < n_vertices) {
+                if (n_awake_m == 0) {
+                    wake_last_set();
+                }
+                choose_sink();
+            }
+        }
+    }
+
+    // Like run, but every sink has an edge of positive capacity from a source if some vertex has
+    // one: the lowest awake such vertex, after waking dormant sets while there is none. Labels are
+    // valid towards the lowest awake vertex only, so another sink, or a set woken next to awake
+    // vertices, needs a global relabel.
+    template <typename Callback>
+    void run_adjacent(std::size_t n_vertices, const std::vector<capacity_edge<DataType>> &edges,
+                      Callback &&on_sink) {
+        start(n_vertices, edges);
+        std::vector<bool> near_sources(n_vertices);
+        auto join_sources = [&](vertex_t vertex) {
+            make_source(vertex);
+            for (std::size_t i = 0; i < graph_m.degree(vertex); ++i) {
+                const auto &edge = graph_m.get_edge_by_vertex(vertex, i);
+                if (edge.from == vertex && edge.capacity > DataType{}) {
+                    near_sources[graph_m.adjacent(vertex, edge)] = true;
+                }
+            }
+        };
+        join_sources(0);
+
+        for (std::size_t n_sources = 1; n_sources < n_vertices; ++n_sources) {
+            bool woken_beside = false;
+            sink_m = n_vertices;
+            while (true) {
+                if (n_awake_m > 0) {
+                    while (label_counts_m[lowest_label_m] == 0) {
+                        ++lowest_label_m;
+                    }
+                    for (std::size_t label = lowest_label_m;
+                         label <= highest_label_m && sink_m == n_vertices; ++label) {
+                        for (vertex_t vertex = bucket_heads_m[label]; vertex != n_vertices;
+                             vertex = bucket_next_m[vertex]) {
+                            if (near_sources[vertex]) {
+                                sink_m = vertex;
+                                break;
+                            }
+                        }
+                    }
+                }
+                if (sink_m != n_vertices || dormant_sets_m.size() == 1) {
+                    break;
+                }
+                woken_beside |= n_awake_m > 0;
+                wake_last_set();
+            }
+            if (sink_m == n_vertices) {
+                choose_sink();
+            }
+            if (woken_beside || labels_m[sink_m] != lowest_label_m) {
+                global_relabel();
+            }
+
+            saturate_sink();
+            on_sink();
+            join_sources(sink_m);
+        }
+    }
+
+    // the preflow of the current run
+    [[nodiscard]] const flows_utils::flow_graph<DataType> &graph() const {
+        return graph_m;
+    }
+
+    [[nodiscard]] vertex_t sink() const {
+        return sink_m;
+    }
+
+    [[nodiscard]] DataType excess(vertex_t vertex) const {
+        return excesses_m[vertex];
+    }
+
+    [[nodiscard]] bool is_source(vertex_t vertex) const {
+        return dormant_m[vertex] == 0;
+    }
+
+    // awake vertices are the sink side of the cut of the current sink
+    [[nodiscard]] bool awake(vertex_t vertex) const {
+        return dormant_m[vertex] == AWAKE;
+    }
+
+    // true marks the side that edges of the cut leave
+    [[nodiscard]] std::vector<bool> find_mincut(std::size_t n_vertices,
+                                                const std::vector<capacity_edge<DataType>> &edges) {
+        if (n_vertices < 2) {
+            return std::vector<bool>(n_vertices);
+        }
+
+        auto forward = source_side_mincut(n_vertices, edges);
+
+        auto reversed_edges = edges;
+        for (auto &edge : reversed_edges) {
+            std::swap(edge.from, edge.to);
+        }
+        auto backward = source_side_mincut(n_vertices, reversed_edges);
+
+        if (backward.first < forward.first) {
+            backward.second.flip();
+            return backward.second;
+        }
+        return forward.second;
+    }
+};
+
+} // namespace push_relabel_solvers
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_PUSH_RELABEL_SOLVERS_HPP
@@ -3,9 +3,11 @@
 #define FLOWS_COURSEWORK_STOER_WAGNER_HPP
 
 #include "dinics_solvers.hpp"
+#include "parallel_utils.hpp"
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <numeric>
-#include <queue>
 #include <vector>
 
 namespace flows_coursework {
@@ -14,81 +16,95 @@ namespace undirected_cuts {
 
 template <typename DataType>
 class stoer_wagner_mincut_solver {
-    std::vector<capacity_edge<DataType>> edges_m;
-    std::vector<std::vector<edge_index_t>> graph_m;
-    std::vector<std::vector<vertex_t>> descendants_m;
-    std::vector<bool> deleted_m;
-    std::vector<bool> result_m;
+    static constexpr std::size_t NO_POSITION = static_cast<std::size_t>(-1);
+
+    // adjacency of super-vertices; neighbours may be merged already and are resolved with find
+    std::vector<std::vector<std::pair<vertex_t, DataType>>> graph_m;
+    flows_utils::disjoint_sets super_vertices_m;
+    // original vertices of a super-vertex form a list from the super-vertex to last_m
+    std::vector<vertex_t> next_m;
+    std::vector<vertex_t> last_m;
+    std::vector<std::size_t> positions_m;
 
     void merge_two(vertex_t a, vertex_t b) {
         // merges b into a
 
-        descendants_m[a].push_back(b);
-        deleted_m[b] = true;
-        for (auto edge_i : graph_m[b]) {
-            if (edges_m[edge_i].from == b) {
-                edges_m[edge_i].from = a;
-            } else if (edges_m[edge_i].to == b) {
-                edges_m[edge_i].to = a;
-            }
-        }
+        super_vertices_m.unite(a, b);
+        next_m[last_m[a]] = b;
+        last_m[a] = last_m[b];
 
-        while (!graph_m[b].empty()) {
-            graph_m[a].push_back(graph_m[b].back());
-            graph_m[b].pop_back();
+        if (graph_m[a].size() < graph_m[b].size()) {
+            std::swap(graph_m[a], graph_m[b]);
         }
+        graph_m[a].insert(graph_m[a].end(), graph_m[b].begin(), graph_m[b].end());
+        graph_m[b].clear();
+        graph_m[b].shrink_to_fit();
     }
 
-    void mark_descendants(vertex_t u) {
-        result_m[u] = true;
-        for (auto v : descendants_m[u]) {
-            mark_descendants(v);
+    // resolves neighbours of vertex, sums parallel edges and drops self-loops
+    void compact(vertex_t vertex) {
+        auto &adjacent = graph_m[vertex];
+        std::size_t size = 0;
+
+        for (std::size_t i = 0; i < adjacent.size(); ++i) {
+            vertex_t other = super_vertices_m.find(adjacent[i].first);
+            if (other == vertex) {
+                continue;
+            }
+            if (positions_m[other] == NO_POSITION) {
+                positions_m[other] = size;
+                adjacent[size++] = {other, adjacent[i].second};
+            } else {
+                adjacent[positions_m[other]].second += adjacent[i].second;
+            }
+        }
+
+        adjacent.resize(size);
+        for (const auto &[other, weight] : adjacent) {
+            positions_m[other] = NO_POSITION;
         }
     }
 
   public:
     [[nodiscard]] std::vector<bool> find_mincut(std::size_t n_vertices,
                                                 const std::vector<capacity_edge<DataType>> &edges) {
-        edges_m = edges;
-        graph_m.resize(n_vertices);
-        descendants_m.resize(n_vertices);
-        deleted_m.resize(n_vertices);
+        graph_m.assign(n_vertices, {});
+        super_vertices_m.reinit(n_vertices);
+        next_m.assign(n_vertices, n_vertices);
+        last_m.resize(n_vertices);
+        std::iota(last_m.begin(), last_m.end(), 0);
+        positions_m.assign(n_vertices, NO_POSITION);
 
-        for (edge_index_t i = 0; i < edges.size(); ++i) {
-            graph_m[edges[i].from].push_back(i);
-            graph_m[edges[i].to].push_back(i);
+        for (const auto &edge : edges) {
+            graph_m[edge.from].emplace_back(edge.to, edge.capacity);
+            graph_m[edge.to].emplace_back(edge.from, edge.capacity);
         }
 
         std::size_t best_cut_vertex = n_vertices;
+        std::size_t best_cut_last = n_vertices;
         DataType best_cut_ans = std::numeric_limits<DataType>::max();
-        std::vector<DataType> weights(n_vertices);
-        std::vector<bool> chosen(n_vertices);
+        // maximum adjacency order: the next vertex is the one most tightly connected to the chosen
+        flows_utils::indexed_heap<DataType> queue_weights(n_vertices);
 
         for (std::size_t phase = 0; phase + 1 < n_vertices; ++phase) {
-            std::fill(weights.begin(), weights.end(), 0);
-            std::fill(chosen.begin(), chosen.end(), false);
-            std::priority_queue<std::pair<DataType, vertex_t>> queue_weights;
+            queue_weights.reinit(n_vertices);
             for (vertex_t v = 0; v < n_vertices; ++v) {
-                if (!deleted_m[v]) {
-                    queue_weights.emplace(0, v);
+                if (super_vertices_m.find(v) == v) {
+                    queue_weights.push(v, DataType{});
                 }
             }
 
             std::size_t last_chosen;
 
             for (std::size_t op = n_vertices - phase; op--;) {
-                while (chosen[queue_weights.top().second]) {
-                    queue_weights.pop();
-                }
-                vertex_t current = queue_weights.top().second;
-                DataType current_mincut = queue_weights.top().first;
-                chosen[current] = true;
-
-                for (edge_index_t edge_index : graph_m[current]) {
-                    auto other = edges_m[edge_index].to + edges_m[edge_index].from - current;
-                    if (!chosen[other]) {
-                        weights[other] += edges_m[edge_index].capacity;
-                        queue_weights.emplace(weights[other], other);
+                vertex_t current = queue_weights.top();
+                DataType current_mincut = queue_weights.key(current);
+                queue_weights.pop();
+
+                compact(current);
+                for (const auto &[other, weight] : graph_m[current]) {
+                    if (queue_weights.contains(other)) {
+                        queue_weights.update(other, queue_weights.key(other) + weight);
                     }
                 }
 
@@ -96,6 +112,7 @@ class stoer_wagner_mincut_solver {
                     if (current_mincut <= best_cut_ans) {
                         best_cut_ans = current_mincut;
                         best_cut_vertex = current;
+                        best_cut_last = last_m[current];
                     }
                     merge_two(last_chosen, current);
                 }
@@ -104,12 +121,170 @@ class stoer_wagner_mincut_solver {
             }
         }
 
-        result_m.resize(n_vertices);
-        mark_descendants(best_cut_vertex);
-        return result_m;
+        std::vector<bool> result(n_vertices);
+        for (vertex_t v = best_cut_vertex; v != n_vertices; v = next_m[v]) {
+            result[v] = true;
+            if (v == best_cut_last) {
+                break;
+            }
+        }
+        return result;
+    }
+};
+
+// Stoer-Wagner on an adjacency matrix. Live super-vertices occupy the first rows and columns, so
+// weight updates and merges are contiguous row additions that the compiler vectorises. Chosen
+// vertices keep a weight below every reachable one, and the next vertex is found without branches:
+// a maximum reduction, then a scan in blocks of BLOCK for its first position. For 64-bit integers
+// both are vectorised from SSE4.2 (-march=x86-64-v2) on; baseline x86-64 has no 64-bit vector
+// comparison, and maxima of doubles are only vectorised with -ffast-math.
+template <typename DataType>
+class dense_stoer_wagner_mincut_solver {
+    static constexpr std::size_t BLOCK = 32;
+    // weights of chosen vertices start here and grow by at most the weight of their edges, so they
+    // stay negative while unchosen weights are not
+    static constexpr DataType CHOSEN = std::numeric_limits<DataType>::lowest();
+
+    std::size_t n_vertices_m = 0;
+    std::vector<DataType> matrix_m;
+    // original vertex of each row
+    std::vector<vertex_t> vertices_m;
+    // original vertices of a super-vertex form a list from the super-vertex to last_m
+    std::vector<vertex_t> next_m;
+    std::vector<vertex_t> last_m;
+    std::vector<DataType> weights_m;
+
+    [[nodiscard]] DataType *row(std::size_t i) {
+        return matrix_m.data() + i * n_vertices_m;
+    }
+
+    // first of the heaviest among the first size weights
+    [[nodiscard]] std::size_t heaviest(std::size_t size) const {
+        const DataType *weights = weights_m.data();
+        DataType best = CHOSEN;
+        for (std::size_t j = 0; j < size; ++j) {
+            best = std::max(best, weights[j]);
+        }
+
+        std::size_t v = 0;
+        for (; v + BLOCK <= size; v += BLOCK) {
+            // an unsigned flag, a bool one keeps the block from being vectorised
+            unsigned found = 0;
+            for (std::size_t i = 0; i < BLOCK; ++i) {
+                found |= weights[v + i] == best;
+            }
+            if (found) {
+                break;
+            }
+        }
+        while (weights[v] != best) {
+            ++v;
+        }
+        return v;
+    }
+
+    // merges row b into row a and moves the last of size rows into the place of b
+    void merge_two(std::size_t a, std::size_t b, std::size_t size) {
+        vertex_t u = vertices_m[a];
+        vertex_t v = vertices_m[b];
+        next_m[last_m[u]] = v;
+        last_m[u] = last_m[v];
+
+        DataType *row_a = row(a);
+        const DataType *row_b = row(b);
+        for (std::size_t j = 0; j < size; ++j) {
+            row_a[j] += row_b[j];
+        }
+        row_a[a] = row_a[b] = DataType{};
+        for (std::size_t j = 0; j < size; ++j) {
+            row(j)[a] = row_a[j];
+        }
+
+        std::size_t last = size - 1;
+        if (b != last) {
+            std::copy(row(last), row(last) + size, row(b));
+            row(b)[b] = DataType{};
+            for (std::size_t j = 0; j < size; ++j) {
+                row(j)[b] = row(b)[j];
+            }
+            vertices_m[b] = vertices_m[last];
+        }
+    }
+
+  public:
+    [[nodiscard]] std::vector<bool> find_mincut(std::size_t n_vertices,
+                                                const std::vector<capacity_edge<DataType>> &edges) {
+        n_vertices_m = n_vertices;
+        matrix_m.assign(n_vertices * n_vertices, DataType{});
+        vertices_m.resize(n_vertices);
+        std::iota(vertices_m.begin(), vertices_m.end(), 0);
+        next_m.assign(n_vertices, n_vertices);
+        last_m.resize(n_vertices);
+        std::iota(last_m.begin(), last_m.end(), 0);
+        weights_m.resize(n_vertices);
+
+        for (const auto &edge : edges) {
+            if (edge.from != edge.to) {
+                row(edge.from)[edge.to] += edge.capacity;
+                row(edge.to)[edge.from] += edge.capacity;
+            }
+        }
+
+        vertex_t best_cut_vertex = n_vertices;
+        vertex_t best_cut_last = n_vertices;
+        DataType best_cut_ans = std::numeric_limits<DataType>::max();
+
+        for (std::size_t size = n_vertices; size > 1; --size) {
+            std::fill(weights_m.begin(), weights_m.begin() + size, DataType{});
+
+            std::size_t last_chosen = 0;
+            for (std::size_t op = 0; op < size; ++op) {
+                std::size_t current = heaviest(size);
+
+                if (op + 1 == size) {
+                    if (weights_m[current] <= best_cut_ans) {
+                        best_cut_ans = weights_m[current];
+                        best_cut_vertex = vertices_m[current];
+                        best_cut_last = last_m[best_cut_vertex];
+                    }
+                    merge_two(last_chosen, current, size);
+                    break;
+                }
+
+                const DataType *row_current = row(current);
+                for (std::size_t j = 0; j < size; ++j) {
+                    weights_m[j] += row_current[j];
+                }
+                weights_m[current] = CHOSEN;
+                last_chosen = current;
+            }
+        }
+
+        std::vector<bool> result(n_vertices);
+        for (vertex_t v = best_cut_vertex; v != n_vertices; v = next_m[v]) {
+            result[v] = true;
+            if (v == best_cut_last) {
+                break;
+            }
+        }
+        return result;
     }
 };
 
+// dense solver is used when the matrix is small enough and at least 1/DENSITY of it is filled
+inline constexpr std::size_t DENSE_STOER_WAGNER_MAX_VERTICES = 4096;
+inline constexpr std::size_t DENSE_STOER_WAGNER_DENSITY = 8;
+
+template <typename DataType>
+[[nodiscard]] std::vector<bool> stoer_wagner_mincut(std::size_t n_vertices,
+                                                    const std::vector<capacity_edge<DataType>> &edges) {
+    if (n_vertices <= DENSE_STOER_WAGNER_MAX_VERTICES &&
+        2 * edges.size() * DENSE_STOER_WAGNER_DENSITY >= n_vertices * n_vertices) {
+        return dense_stoer_wagner_mincut_solver<DataType>().find_mincut(n_vertices, edges);
+    }
+    return stoer_wagner_mincut_solver<DataType>().find_mincut(n_vertices, edges);
+}
+
 template <typename DataType>
 DataType cut_size(const std::vector<capacity_edge<DataType>> &edges, const std::vector<bool> &cut) {
 
@@ -124,27 +299,41 @@ DataType cut_size(const std::vector<capacity_edge<DataType>> &edges, const std::
 
 template <typename T>
 T global_mincut_size_wagner(std::size_t n, const std::vector<capacity_edge<T>> &data) {
-    return cut_size(data, stoer_wagner_mincut_solver<T>().find_mincut(n, data));
+    return cut_size(data, stoer_wagner_mincut(n, data));
 }
 
+// Some minimum cut separates vertex 0 from another vertex, so n - 1 maximum flows from vertex 0
+// suffice. Flows run in parallel on copies of one undirected flow graph and stop as soon as they
+// reach the lightest cut found so far, starting from the lightest vertex.
 template <typename T>
-T global_mincut_size_dinics(std::size_t n, const std::vector<capacity_edge<T>> &data) {
-    T ans = std::numeric_limits<T>::max();
+T global_mincut_size_dinics(std::size_t n, const std::vector<capacity_edge<T>> &data,
+                            std::size_t n_threads = parallel_utils::default_threads_count()) {
+    if (n < 2) {
+        return std::numeric_limits<T>::max();
+    }
 
-    auto data_copy = data;
+    std::vector<T> degrees(n);
     for (const auto &edge : data) {
-        data_copy.emplace_back(edge.to, edge.from, edge.capacity);
+        if (edge.from != edge.to) {
+            degrees[edge.from] += edge.capacity;
+            degrees[edge.to] += edge.capacity;
+        }
     }
+    std::atomic<T> best = *std::min_element(degrees.begin(), degrees.end());
 
-    for (std::size_t s = 0; s < n; ++s) {
-        for (std::size_t t = 0; t < s; ++t) {
-            ans = std::min(ans,
-                           flows_utils::flow_size(
-                               s, data_copy,
-                               dinics_solvers::basic_dinics_solver<T>().solve(n, s, t, data_copy)));
+    const auto prepared = flows_utils::flow_graph<T>::undirected(n, 0, 0, data);
+    parallel_utils::parallel_for(n - 1, n_threads, [&](std::size_t i) {
+        auto graph = prepared;
+        graph.set_terminals(0, i + 1);
+        T value = dinics_solvers::basic_dinics_solver<T>().flow_value(std::move(graph),
+                                                                      best.load());
+        for (T current = best.load(); value < current;) {
+            if (best.compare_exchange_weak(current, value)) {
+                break;
+            }
         }
-    }
-    return ans;
+    });
+    return best.load();
 }
 
 } // namespace undirected_cuts
@@ -0,0 +1,455 @@
+#ifndef FLOWS_COURSEWORK_TREE_PACKING_HPP
+#define FLOWS_COURSEWORK_TREE_PACKING_HPP
+
+#include "stoer_wagner.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace undirected_cuts {
+
+namespace detail {
+
+// Bottom-up segment tree with range additions and range minimum with its position. Additions
+// stay in the nodes that cover a range and are pushed down only on the paths to query ends.
+template <typename DataType>
+class range_add_min_tree {
+    std::size_t size_m = 0;
+    std::size_t leaves_m = 1;
+    std::size_t height_m = 0;
+    std::vector<std::pair<DataType, std::size_t>> min_m;
+    std::vector<DataType> add_m;
+
+    void apply(std::size_t node, DataType value) {
+        min_m[node].first += value;
+        if (node < leaves_m) {
+            add_m[node] += value;
+        }
+    }
+
+    void pull(std::size_t node) {
+        for (node >>= 1; node > 0; node >>= 1) {
+            min_m[node] = std::min(min_m[2 * node], min_m[2 * node + 1]);
+            min_m[node].first += add_m[node];
+        }
+    }
+
+    void push(std::size_t node) {
+        for (std::size_t shift = height_m; shift > 0; --shift) {
+            std::size_t ancestor = node >> shift;
+            if (add_m[ancestor] != DataType{}) {
+                apply(2 * ancestor, add_m[ancestor]);
+                apply(2 * ancestor + 1, add_m[ancestor]);
+                add_m[ancestor] = DataType{};
+            }
+        }
+    }
+
+  public:
+    void reinit(const std::vector<DataType> &values) {
+        size_m = values.size();
+        for (leaves_m = 1, height_m = 0; leaves_m < size_m; leaves_m *= 2, ++height_m) {
+        }
+        min_m.assign(2 * leaves_m, {std::numeric_limits<DataType>::max(), size_m});
+        add_m.assign(leaves_m, DataType{});
+        for (std::size_t i = 0; i < size_m; ++i) {
+            min_m[leaves_m + i] = {values[i], i};
+        }
+        for (std::size_t node = leaves_m; node-- > 1;) {
+            min_m[node] = std::min(min_m[2 * node], min_m[2 * node + 1]);
+        }
+    }
+
+    // adds value on [left, right)
+    void add(std::size_t left, std::size_t right, DataType value) {
+        if (left >= right) {
+            return;
+        }
+        std::size_t first = left + leaves_m;
+        std::size_t last = right - 1 + leaves_m;
+        for (left += leaves_m, right += leaves_m; left < right; left >>= 1, right >>= 1) {
+            if (left & 1) {
+                apply(left++, value);
+            }
+            if (right & 1) {
+                apply(--right, value);
+            }
+        }
+        pull(first);
+        pull(last);
+    }
+
+    // minimum on [left, right) and its position, the position is size() for an empty range
+    [[nodiscard]] std::pair<DataType, std::size_t> min(std::size_t left, std::size_t right) {
+        std::pair<DataType, std::size_t> result{std::numeric_limits<DataType>::max(), size_m};
+        if (left >= right) {
+            return result;
+        }
+        push(left + leaves_m);
+        push(right - 1 + leaves_m);
+        for (left += leaves_m, right += leaves_m; left < right; left >>= 1, right >>= 1) {
+            if (left & 1) {
+                result = std::min(result, min_m[left++]);
+            }
+            if (right & 1) {
+                result = std::min(result, min_m[--right]);
+            }
+        }
+        return result;
+    }
+};
+
+} // namespace detail
+
+// Exact minimum cut by tree packing: trees are packed greedily, each one a minimum spanning tree
+// with respect to load / capacity of the edges, and for every tree the lightest cut crossing at
+// most two of its edges is found. With weight 1 / max(load / capacity) per tree, k trees pack
+// P = k / max(load / capacity) into the capacities, so a cut crossing all of them three times or
+// more weighs at least 3P: once 3P reaches the lightest cut found, that cut is minimum. Greedy
+// packings approach the maximum packing, which is at least half the minimum cut, so the loop ends.
+// The number of trees grows with the minimum cut relative to the capacities, to about n / 3 on
+// complete graphs; Karger bounds it by O(log n) packing a sampled skeleton instead, at the price of
+// a Monte Carlo answer. For every tree the cut is found with heavy path decomposition and segment
+// trees.
+// Let C(v) be the weight of edges leaving subtree T(v). A cut crossing edges above v and w weighs
+//   C(v) + C(w) - 2 c(T(v), T(w))       when v and w are incomparable,
+//   C(v) + C(w) - 2 c(T(w), V \ T(v))  when w is below v, the cut side being T(v) \ T(w).
+// The heavy path of v is swept upwards; vertices entering T(v) add the weights of their edges on
+// root paths in one segment tree per case, and the minimum over valid w is a range query.
+template <typename DataType>
+class tree_packing_mincut_solver {
+    static constexpr vertex_t NO_VERTEX = std::numeric_limits<vertex_t>::max();
+
+    enum class cut_type { SUBTREE, INCOMPARABLE, NESTED };
+
+    std::size_t n_vertices_m = 0;
+    std::vector<std::vector<std::pair<vertex_t, DataType>>> graph_m;
+    std::vector<capacity_edge<DataType>> edges_m;
+
+    // current tree
+    std::vector<std::vector<vertex_t>> children_m;
+    std::vector<vertex_t> parents_m;
+    std::vector<vertex_t> heavy_m;
+    std::vector<vertex_t> heads_m;
+    std::vector<std::size_t> sizes_m;
+    std::vector<std::size_t> positions_m;
+    std::vector<vertex_t> vertex_at_m;
+    std::vector<DataType> subtree_cuts_m;
+
+    detail::range_add_min_tree<DataType> incomparable_m;
+    detail::range_add_min_tree<DataType> nested_m;
+    std::vector<std::pair<vertex_t, DataType>> incomparable_log_m;
+    std::vector<std::pair<vertex_t, DataType>> nested_log_m;
+
+    DataType best_weight_m{};
+    cut_type best_type_m{};
+    vertex_t best_v_m = NO_VERTEX;
+    vertex_t best_w_m = NO_VERTEX;
+
+    void build_graph(const std::vector<capacity_edge<DataType>> &edges) {
+        std::vector<vertex_t> identity(n_vertices_m);
+        std::iota(identity.begin(), identity.end(), 0);
+        edges_m = flows_utils::contracted_edges(n_vertices_m, edges, identity);
+        // zero edges cross cuts for free and would take infinite load / capacity in trees
+        edges_m.erase(std::remove_if(edges_m.begin(), edges_m.end(),
+                                     [](const auto &edge) { return edge.capacity <= DataType{}; }),
+                      edges_m.end());
+
+        graph_m.assign(n_vertices_m, {});
+        for (const auto &edge : edges_m) {
+            graph_m[edge.from].emplace_back(edge.to, edge.capacity);
+            graph_m[edge.to].emplace_back(edge.from, edge.capacity);
+        }
+    }
+
+    // next tree of the greedy packing: a minimum spanning tree with respect to the load / capacity
+    // it would leave on edges, so that the first one is a maximum spanning tree
+    [[nodiscard]] std::vector<edge_index_t> pack_tree(std::vector<std::size_t> &loads) const {
+        std::vector<edge_index_t> order(edges_m.size());
+        std::iota(order.begin(), order.end(), 0);
+        auto next_load = [&](edge_index_t i) {
+            return static_cast<double>(loads[i] + 1) / static_cast<double>(edges_m[i].capacity);
+        };
+        std::sort(order.begin(), order.end(), [&](edge_index_t lhs, edge_index_t rhs) {
+            return next_load(lhs) < next_load(rhs);
+        });
+
+        std::vector<edge_index_t> tree;
+        flows_utils::disjoint_sets components(n_vertices_m);
+        for (edge_index_t i : order) {
+            if (components.unite(edges_m[i].from, edges_m[i].to)) {
+                tree.push_back(i);
+                ++loads[i];
+            }
+        }
+        return tree;
+    }
+
+    // roots the tree at 0 and lays heavy paths and subtrees out contiguously
+    void build_tree(const std::vector<edge_index_t> &tree) {
+        children_m.assign(n_vertices_m, {});
+        std::vector<std::vector<vertex_t>> adjacent(n_vertices_m);
+        for (edge_index_t i : tree) {
+            adjacent[edges_m[i].from].push_back(edges_m[i].to);
+            adjacent[edges_m[i].to].push_back(edges_m[i].from);
+        }
+
+        std::vector<vertex_t> order{0};
+        parents_m.assign(n_vertices_m, NO_VERTEX);
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            for (vertex_t child : adjacent[order[i]]) {
+                if (child != parents_m[order[i]]) {
+                    parents_m[child] = order[i];
+                    children_m[order[i]].push_back(child);
+                    order.push_back(child);
+                }
+            }
+        }
+
+        sizes_m.assign(n_vertices_m, 1);
+        heavy_m.assign(n_vertices_m, NO_VERTEX);
+        for (std::size_t i = order.size(); i-- > 1;) {
+            sizes_m[parents_m[order[i]]] += sizes_m[order[i]];
+        }
+        for (vertex_t v = 0; v < n_vertices_m; ++v) {
+            for (vertex_t child : children_m[v]) {
+                if (heavy_m[v] == NO_VERTEX || sizes_m[child] > sizes_m[heavy_m[v]]) {
+                    heavy_m[v] = child;
+                }
+            }
+        }
+
+        heads_m.assign(n_vertices_m, 0);
+        positions_m.assign(n_vertices_m, 0);
+        vertex_at_m.assign(n_vertices_m, 0);
+        std::vector<vertex_t> stack{0};
+        for (std::size_t position = 0; !stack.empty(); ++position) {
+            vertex_t v = stack.back();
+            stack.pop_back();
+            positions_m[v] = position;
+            vertex_at_m[position] = v;
+            for (vertex_t child : children_m[v]) {
+                if (child != heavy_m[v]) {
+                    heads_m[child] = child;
+                    stack.push_back(child);
+                }
+            }
+            if (heavy_m[v] != NO_VERTEX) {
+                heads_m[heavy_m[v]] = heads_m[v];
+                stack.push_back(heavy_m[v]);
+            }
+        }
+    }
+
+    [[nodiscard]] bool in_subtree(vertex_t root, vertex_t vertex) const {
+        return positions_m[root] <= positions_m[vertex] &&
+               positions_m[vertex] < positions_m[root] + sizes_m[root];
+    }
+
+    [[nodiscard]] vertex_t lca(vertex_t u, vertex_t v) const {
+        while (heads_m[u] != heads_m[v]) {
+            if (positions_m[heads_m[u]] > positions_m[heads_m[v]]) {
+                u = parents_m[heads_m[u]];
+            } else {
+                v = parents_m[heads_m[v]];
+            }
+        }
+        return positions_m[u] < positions_m[v] ? u : v;
+    }
+
+    void add_on_root_path(detail::range_add_min_tree<DataType> &tree, vertex_t vertex,
+                          DataType value) {
+        for (; vertex != NO_VERTEX; vertex = parents_m[heads_m[vertex]]) {
+            tree.add(positions_m[heads_m[vertex]], positions_m[vertex] + 1, value);
+        }
+    }
+
+    void compute_subtree_cuts() {
+        subtree_cuts_m.assign(n_vertices_m, DataType{});
+        for (const auto &edge : edges_m) {
+            subtree_cuts_m[edge.from] += edge.capacity;
+            subtree_cuts_m[edge.to] += edge.capacity;
+            subtree_cuts_m[lca(edge.from, edge.to)] -= 2 * edge.capacity;
+        }
+        for (std::size_t position = n_vertices_m; position-- > 1;) {
+            vertex_t v = vertex_at_m[position];
+            subtree_cuts_m[parents_m[v]] += subtree_cuts_m[v];
+        }
+    }
+
+    void update_best(DataType weight, cut_type type, vertex_t v, vertex_t w) {
+        if (weight < best_weight_m) {
+            best_weight_m = weight;
+            best_type_m = type;
+            best_v_m = v;
+            best_w_m = w;
+        }
+    }
+
+    // lightest cut over vertices incomparable with v
+    [[nodiscard]] std::pair<DataType, std::size_t> min_incomparable(vertex_t v) {
+        // ancestors of v occupy one prefix of every heavy path on the root path
+        std::vector<std::pair<std::size_t, std::size_t>> excluded{
+            {positions_m[v], positions_m[v] + sizes_m[v]}};
+        for (vertex_t u = v; u != NO_VERTEX; u = parents_m[heads_m[u]]) {
+            excluded.emplace_back(positions_m[heads_m[u]], positions_m[u] + 1);
+        }
+        std::sort(excluded.begin(), excluded.end());
+
+        std::pair<DataType, std::size_t> result{std::numeric_limits<DataType>::max(),
+                                                n_vertices_m};
+        std::size_t begin = 0;
+        for (const auto &[left, right] : excluded) {
+            result = std::min(result, incomparable_m.min(begin, left));
+            begin = std::max(begin, right);
+        }
+        return std::min(result, incomparable_m.min(begin, n_vertices_m));
+    }
+
+    void sweep_heavy_path(vertex_t head) {
+        vertex_t bottom = head;
+        while (heavy_m[bottom] != NO_VERTEX) {
+            bottom = heavy_m[bottom];
+        }
+
+        incomparable_log_m.clear();
+        nested_log_m.clear();
+        for (vertex_t v = bottom; v != parents_m[head]; v = parents_m[v]) {
+            if (v == 0) {
+                break;
+            }
+            // v and its light subtrees enter T(v)
+            std::size_t old_begin = positions_m[v] + 1;
+            std::size_t old_end = old_begin + (heavy_m[v] == NO_VERTEX ? 0 : sizes_m[heavy_m[v]]);
+            auto is_old = [&](vertex_t u) {
+                return old_begin <= positions_m[u] && positions_m[u] < old_end;
+            };
+
+            for (std::size_t position = positions_m[v]; position < positions_m[v] + sizes_m[v];
+                 position = position == positions_m[v] ? old_end : position + 1) {
+                vertex_t x = vertex_at_m[position];
+                for (const auto &[y, weight] : graph_m[x]) {
+                    // edges inside T(v) only change vertices excluded from both queries
+                    if (!in_subtree(v, y)) {
+                        add_on_root_path(incomparable_m, y, -2 * weight);
+                        incomparable_log_m.emplace_back(y, -2 * weight);
+                        add_on_root_path(nested_m, x, -2 * weight);
+                        nested_log_m.emplace_back(x, -2 * weight);
+                    } else if (is_old(y)) {
+                        add_on_root_path(nested_m, y, 2 * weight);
+                        nested_log_m.emplace_back(y, 2 * weight);
+                    }
+                }
+            }
+
+            update_best(subtree_cuts_m[v], cut_type::SUBTREE, v, NO_VERTEX);
+
+            auto nested = nested_m.min(positions_m[v] + 1, positions_m[v] + sizes_m[v]);
+            if (nested.second != n_vertices_m) {
+                update_best(subtree_cuts_m[v] + nested.first, cut_type::NESTED, v,
+                            vertex_at_m[nested.second]);
+            }
+
+            auto incomparable = min_incomparable(v);
+            if (incomparable.second != n_vertices_m) {
+                update_best(subtree_cuts_m[v] + incomparable.first, cut_type::INCOMPARABLE, v,
+                            vertex_at_m[incomparable.second]);
+            }
+        }
+
+        for (const auto &[vertex, value] : incomparable_log_m) {
+            add_on_root_path(incomparable_m, vertex, -value);
+        }
+        for (const auto &[vertex, value] : nested_log_m) {
+            add_on_root_path(nested_m, vertex, -value);
+        }
+    }
+
+  public:
+    [[nodiscard]] std::vector<bool> find_mincut(std::size_t n_vertices,
+                                                const std::vector<capacity_edge<DataType>> &edges) {
+        n_vertices_m = n_vertices;
+        std::vector<bool> result(n_vertices);
+        if (n_vertices < 2) {
+            return result;
+        }
+
+        build_graph(edges);
+
+        // a disconnected graph has a cut of zero weight around the component of 0
+        flows_utils::disjoint_sets components(n_vertices);
+        for (const auto &edge : edges_m) {
+            components.unite(edge.from, edge.to);
+        }
+        if (components.sets_count() > 1) {
+            for (vertex_t v = 0; v < n_vertices; ++v) {
+                result[v] = components.find(v) == components.find(0);
+            }
+            return result;
+        }
+
+        best_weight_m = std::numeric_limits<DataType>::max();
+        std::vector<edge_index_t> best_tree;
+        std::vector<std::size_t> loads(edges_m.size());
+        edge_index_t heaviest = 0; // the edge with maximum load / capacity
+        for (std::size_t n_trees = 1;; ++n_trees) {
+            auto tree = pack_tree(loads);
+            for (edge_index_t i : tree) {
+                if (static_cast<DataType>(loads[i]) * edges_m[heaviest].capacity >
+                    static_cast<DataType>(loads[heaviest]) * edges_m[i].capacity) {
+                    heaviest = i;
+                }
+            }
+
+            build_tree(tree);
+            compute_subtree_cuts();
+            std::vector<DataType> initial(n_vertices);
+            for (vertex_t v = 0; v < n_vertices; ++v) {
+                initial[positions_m[v]] = subtree_cuts_m[v];
+            }
+            incomparable_m.reinit(initial);
+            nested_m.reinit(initial);
+
+            DataType previous_best = best_weight_m;
+            for (vertex_t v = 0; v < n_vertices; ++v) {
+                if (heads_m[v] == v) {
+                    sweep_heavy_path(v);
+                }
+            }
+            if (best_weight_m < previous_best) {
+                best_tree = std::move(tree);
+            }
+
+            // 3P >= best with P = n_trees * capacity / load of the heaviest edge
+            if (best_weight_m * static_cast<DataType>(loads[heaviest]) <=
+                3 * static_cast<DataType>(n_trees) * edges_m[heaviest].capacity) {
+                break;
+            }
+        }
+
+        build_tree(best_tree);
+        for (vertex_t u = 0; u < n_vertices; ++u) {
+            switch (best_type_m) {
+            case cut_type::SUBTREE:
+                result[u] = in_subtree(best_v_m, u);
+                break;
+            case cut_type::INCOMPARABLE:
+                result[u] = in_subtree(best_v_m, u) || in_subtree(best_w_m, u);
+                break;
+            case cut_type::NESTED:
+                result[u] = in_subtree(best_v_m, u) && !in_subtree(best_w_m, u);
+                break;
+            }
+        }
+        return result;
+    }
+};
+
+} // namespace undirected_cuts
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_TREE_PACKING_HPP
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cstdint>
+#include <doctest.h>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../auction.hpp"
+#include "../min_cost_flow.hpp"
+
+using flows_coursework::cost_edge;
+using flows_coursework::vertex_t;
+using flows_coursework::assignment::auction_assignment_solver;
+using flows_coursework::min_cost_flows::successive_shortest_paths_solver;
+
+static std::mt19937 generator{47}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static std::vector<cost_edge<int64_t>> random_weights(int n, double density, int64_t min_weight,
+                                                      int64_t max_weight) {
+    std::vector<cost_edge<int64_t>> data;
+    for (int u = 0; u < n; ++u) {
+        for (int v = 0; v < n; ++v) {
+            if (std::uniform_real_distribution<double>(0, 1)(generator) < density) {
+                data.emplace_back(u, v, 1,
+                                  std::uniform_int_distribution<int64_t>(min_weight,
+                                                                         max_weight)(generator));
+            }
+        }
+    }
+    return data;
+}
+
+// the heaviest parallel edge of every pair, minimum of int64_t where there is none
+static std::vector<std::vector<int64_t>>
+weight_matrix(int n, const std::vector<cost_edge<int64_t>> &data) {
+    std::vector<std::vector<int64_t>> matrix(
+        n, std::vector<int64_t>(n, std::numeric_limits<int64_t>::min()));
+    for (const auto &edge : data) {
+        if (edge.capacity > 0) {
+            matrix[edge.from][edge.to] = std::max(matrix[edge.from][edge.to], edge.cost);
+        }
+    }
+    return matrix;
+}
+
+// weight of an assignment, minimum of int64_t if it is not a perfect matching
+static int64_t assignment_weight(int n, const std::vector<cost_edge<int64_t>> &data,
+                                 const std::vector<vertex_t> &assigned) {
+    auto matrix = weight_matrix(n, data);
+    std::vector<bool> taken(n, false);
+    int64_t weight = 0;
+    for (int u = 0; u < n; ++u) {
+        if (assigned[u] >= static_cast<vertex_t>(n) || taken[assigned[u]] ||
+            matrix[u][assigned[u]] == std::numeric_limits<int64_t>::min()) {
+            return std::numeric_limits<int64_t>::min();
+        }
+        taken[assigned[u]] = true;
+        weight += matrix[u][assigned[u]];
+    }
+    return weight;
+}
+
+static int64_t brute_force(int n, const std::vector<cost_edge<int64_t>> &data) {
+    std::vector<vertex_t> permutation(n);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    int64_t best = std::numeric_limits<int64_t>::min();
+    do {
+        best = std::max(best, assignment_weight(n, data, permutation));
+    } while (std::next_permutation(permutation.begin(), permutation.end()));
+    return best;
+}
+
+TEST_CASE("small assignments agree with brute force") {
+    int iterations = 500;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(1, 7)(generator);
+        double density = iterations % 2 ? 1.0 : 0.4;
+        auto data = random_weights(n, density, iterations % 3 ? 0 : -20, 20);
+        int64_t expected = brute_force(n, data);
+
+        auction_assignment_solver<int64_t> solver(iterations % 4 + 1);
+        auto assigned = solver.solve(n, data);
+        if (expected == std::numeric_limits<int64_t>::min()) {
+            CHECK(assigned.empty());
+            continue;
+        }
+        REQUIRE_EQ(assigned.size(), n);
+        CHECK_EQ(assignment_weight(n, data, assigned), expected);
+        CHECK_EQ(solver.weight(), expected);
+    }
+}
+
+TEST_CASE("no perfect matching") {
+    // left vertices 0 and 1 only know right vertex 0
+    std::vector<cost_edge<int64_t>> data{{0, 0, 1, 5}, {1, 0, 1, 7}, {2, 1, 1, 1}, {2, 2, 1, 1}};
+
+    auction_assignment_solver<int64_t> solver;
+    CHECK(solver.solve(3, data).empty());
+    CHECK(solver.solve(3, {}).empty());
+    CHECK(solver.solve(0, {}).empty());
+}
+
+TEST_CASE("agrees with min-cost flow and every threads count") {
+    int iterations = 20;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(20, 80)(generator);
+        auto data = random_weights(n, iterations % 2 ? 1.0 : 0.1, -1000, 1000000);
+        for (int u = 0; u < n; ++u) {
+            data.emplace_back(u, u, 1, 0);
+        }
+
+        std::vector<cost_edge<int64_t>> network;
+        for (const auto &edge : data) {
+            network.emplace_back(edge.from, n + edge.to, 1, -edge.cost);
+        }
+        for (int u = 0; u < n; ++u) {
+            network.emplace_back(2 * n, u, 1, 0);
+            network.emplace_back(n + u, 2 * n + 1, 1, 0);
+        }
+        successive_shortest_paths_solver<int64_t> expected;
+        expected.solve(2 * n + 2, 2 * n, 2 * n + 1, network);
+        REQUIRE_EQ(expected.flow_value(), n);
+
+        std::vector<vertex_t> first;
+        for (std::size_t threads : {1, 2, 5}) {
+            auction_assignment_solver<int64_t> solver(threads);
+            auto assigned = solver.solve(n, data);
+            CHECK_EQ(solver.weight(), -expected.cost());
+            CHECK_EQ(assignment_weight(n, data, assigned), -expected.cost());
+            if (first.empty()) {
+                first = assigned;
+            }
+            CHECK_EQ(assigned, first);
+        }
+    }
+}
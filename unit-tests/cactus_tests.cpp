@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <cstdint>
+#include <doctest.h>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../cactus.hpp"
+#include "../stoer_wagner.hpp"
+
+using flows_coursework::capacity_edge;
+using flows_coursework::undirected_cuts::cut_size;
+using flows_coursework::undirected_cuts::global_mincut_size_wagner;
+using flows_coursework::undirected_cuts::mincut_cactus;
+
+static std::mt19937 generator{44}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static std::vector<capacity_edge<int64_t>> random_graph(int n, int m, int64_t max_capacity) {
+    std::vector<capacity_edge<int64_t>> data;
+    for (int i = 0; i < m; ++i) {
+        data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                          std::uniform_int_distribution<int>(0, n - 1)(generator),
+                          std::uniform_int_distribution<int64_t>(1, max_capacity)(generator));
+    }
+    return data;
+}
+
+// cycles through random orders of the vertices, so many minimum cuts cross
+static std::vector<capacity_edge<int64_t>> random_cycles(int n, int n_cycles) {
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    std::vector<capacity_edge<int64_t>> data;
+    while (n_cycles--) {
+        std::shuffle(order.begin(), order.end(), generator);
+        int length = std::uniform_int_distribution<int>(2, n)(generator);
+        for (int i = 0; i < length; ++i) {
+            data.emplace_back(order[i], order[(i + 1) % length], 1);
+        }
+    }
+    return data;
+}
+
+static std::vector<bool> mask_to_side(int n, int mask) {
+    std::vector<bool> side(n);
+    for (int v = 0; v < n; ++v) {
+        side[v] = (mask >> v) & 1;
+    }
+    return side;
+}
+
+static int side_to_mask(const std::vector<bool> &side) {
+    int mask = 0;
+    for (std::size_t v = 0; v < side.size(); ++v) {
+        mask |= static_cast<int>(side[v]) << v;
+    }
+    return mask;
+}
+
+static void check_brute_force(int n, const std::vector<capacity_edge<int64_t>> &data) {
+    mincut_cactus<int64_t> cactus(n, data);
+
+    int64_t best = std::numeric_limits<int64_t>::max();
+    std::set<int> expected;
+    for (int mask = 2; mask < (1 << n); mask += 2) {
+        int64_t value = cut_size(data, mask_to_side(n, mask));
+        if (value < best) {
+            best = value;
+            expected.clear();
+        }
+        if (value == best) {
+            expected.insert(mask);
+        }
+    }
+
+    CHECK_EQ(cactus.mincut_value(), best);
+    CHECK_EQ(cactus.mincuts_count(), expected.size());
+
+    std::set<int> listed;
+    cactus.for_each_mincut([&](const std::vector<bool> &side) {
+        CHECK_FALSE(side[0]);
+        CHECK_EQ(cut_size(data, side), best);
+        CHECK(listed.insert(side_to_mask(side)).second);
+    });
+    CHECK_EQ(listed, expected);
+
+    for (int mask = 0; mask < (1 << n); ++mask) {
+        bool minimum = expected.count(mask) || expected.count(((1 << n) - 1) ^ mask);
+        CHECK_EQ(cactus.is_mincut(mask_to_side(n, mask)), minimum);
+    }
+
+    for (int u = 0; u < n; ++u) {
+        for (int v = 0; v < n; ++v) {
+            bool separated = false;
+            for (int mask : expected) {
+                separated |= ((mask >> u) & 1) != ((mask >> v) & 1);
+            }
+            CHECK_EQ(cactus.separable(u, v), separated);
+        }
+    }
+}
+
+TEST_CASE("cycle") {
+    int n = 8;
+
+    std::vector<capacity_edge<int64_t>> data;
+    for (int i = 0; i < n; ++i) {
+        data.emplace_back(i, (i + 1) % n, 3);
+    }
+
+    mincut_cactus<int64_t> cactus(n, data);
+    CHECK_EQ(cactus.mincut_value(), 6);
+    CHECK_EQ(cactus.mincuts_count(), n * (n - 1) / 2);
+    CHECK_EQ(cactus.nodes_count(), n);
+    check_brute_force(n, data);
+}
+
+TEST_CASE("cycle hanging from an empty node") {
+    // cycle 0 - 1 - t - 2 with an empty node t that is the top of the cycle t - 3 - 4 - 5
+    std::vector<capacity_edge<int64_t>> data{{0, 1, 2}, {2, 0, 2}, {3, 4, 2}, {4, 5, 2},
+                                             {1, 3, 1}, {1, 5, 1}, {2, 3, 1}, {2, 5, 1}};
+    int n = 6;
+
+    mincut_cactus<int64_t> cactus(n, data);
+    CHECK_EQ(cactus.mincut_value(), 4);
+    CHECK_EQ(cactus.nodes_count(), 7);
+    CHECK_EQ(cactus.mincuts_count(), 11);
+    check_brute_force(n, data);
+}
+
+TEST_CASE("disconnected graph") {
+    std::vector<capacity_edge<int64_t>> data{{0, 1, 2}, {2, 3, 1}, {4, 4, 5}, {5, 6, 0}};
+    int n = 7;
+
+    mincut_cactus<int64_t> cactus(n, data);
+    CHECK_EQ(cactus.mincut_value(), 0);
+    CHECK_EQ(cactus.nodes_count(), 5);
+    CHECK_EQ(cactus.mincuts_count(), 15);
+    CHECK_FALSE(cactus.separable(0, 1));
+    CHECK(cactus.separable(5, 6));
+    check_brute_force(n, data);
+}
+
+TEST_CASE("brute force over all cuts") {
+    int iterations = 300;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 9)(generator);
+        if (iterations % 2) {
+            check_brute_force(n, random_graph(n, std::uniform_int_distribution<int>(n, 3 * n)(
+                                                     generator),
+                                              iterations % 3 + 1));
+        } else {
+            check_brute_force(n, random_cycles(n, std::uniform_int_distribution<int>(1, 3)(
+                                                      generator)));
+        }
+    }
+}
+
+TEST_CASE("large cycle of cliques") {
+    int n_cliques = 60;
+    int clique_size = 4;
+    int n = n_cliques * clique_size;
+
+    std::vector<capacity_edge<int64_t>> data;
+    for (int c = 0; c < n_cliques; ++c) {
+        for (int i = 0; i < clique_size; ++i) {
+            for (int j = i + 1; j < clique_size; ++j) {
+                data.emplace_back(c * clique_size + i, c * clique_size + j, 5);
+            }
+        }
+        data.emplace_back(c * clique_size, ((c + 1) % n_cliques) * clique_size + 1, 2);
+    }
+
+    mincut_cactus<int64_t> cactus(n, data);
+    CHECK_EQ(cactus.mincut_value(), global_mincut_size_wagner<int64_t>(n, data));
+    CHECK_EQ(cactus.mincut_value(), 4);
+    CHECK_EQ(cactus.nodes_count(), n_cliques);
+    CHECK_EQ(cactus.mincuts_count(), n_cliques * (n_cliques - 1) / 2);
+
+    std::size_t listed = 0;
+    cactus.for_each_mincut([&](const std::vector<bool> &side) {
+        ++listed;
+        CHECK_EQ(cut_size(data, side), 4);
+        CHECK(cactus.is_mincut(side));
+    });
+    CHECK_EQ(listed, cactus.mincuts_count());
+}
+
+TEST_CASE("long cycle") {
+    // n (n - 1) / 2 crossing cuts, all in one cycle of the cactus
+    int n = 2000;
+
+    std::vector<capacity_edge<int64_t>> data;
+    for (int i = 0; i < n; ++i) {
+        data.emplace_back(i, (i + 1) % n, 1);
+    }
+
+    mincut_cactus<int64_t> cactus(n, data);
+    CHECK_EQ(cactus.mincut_value(), 2);
+    CHECK_EQ(cactus.nodes_count(), n);
+    CHECK_EQ(cactus.mincuts_count(), static_cast<std::size_t>(n) * (n - 1) / 2);
+
+    for (int iteration = 0; iteration < 100; ++iteration) {
+        int first = std::uniform_int_distribution<int>(0, n - 1)(generator);
+        int length = std::uniform_int_distribution<int>(1, n - 3)(generator);
+        std::vector<bool> side(n);
+        for (int i = 0; i < length; ++i) {
+            side[(first + i) % n] = true;
+        }
+        CHECK(cactus.is_mincut(side));
+        // a second arc cuts four edges
+        side[(first + length + 1) % n] = true;
+        CHECK_FALSE(cactus.is_mincut(side));
+    }
+}
+
+TEST_CASE("random graphs agree with stoer wagner") {
+    int iterations = 20;
+
+    while (iterations--) {
+        int n = 200;
+        auto data = random_graph(n, 3 * n, 10);
+        for (int v = 0; v + 1 < n; ++v) {
+            data.emplace_back(v, v + 1, 1);
+        }
+
+        mincut_cactus<int64_t> cactus(n, data);
+        CHECK_EQ(cactus.mincut_value(), global_mincut_size_wagner<int64_t>(n, data));
+        std::size_t listed = 0;
+        cactus.for_each_mincut([&](const std::vector<bool> &side) {
+            ++listed;
+            CHECK_EQ(cut_size(data, side), cactus.mincut_value());
+        });
+        CHECK_EQ(listed, cactus.mincuts_count());
+    }
+}
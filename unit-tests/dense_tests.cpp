@@ -0,0 +1,67 @@
+#include <cstdint>
+#include <doctest.h>
+#include <random>
+#include <vector>
+
+#include "../dense_solvers.hpp"
+
+using flows_coursework::capacity_edge;
+using flows_coursework::dense_solvers::dense_dinics_solver;
+using flows_coursework::dense_solvers::density_aware_solver;
+using flows_coursework::dinics_solvers::basic_dinics_solver;
+using flows_coursework::flows_utils::flow_size;
+
+static std::mt19937 generator{49}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static void check_flow(std::size_t n, std::size_t s, std::size_t t,
+                       const std::vector<capacity_edge<int64_t>> &data,
+                       const std::vector<int64_t> &flow) {
+    REQUIRE_EQ(flow.size(), data.size());
+    std::vector<int64_t> balance(n, 0);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        CHECK(flow[i] >= 0);
+        CHECK(flow[i] <= data[i].capacity);
+        balance[data[i].from] -= flow[i];
+        balance[data[i].to] += flow[i];
+    }
+    for (std::size_t v = 0; v < n; ++v) {
+        if (v != s && v != t) {
+            CHECK_EQ(balance[v], 0);
+        }
+    }
+    CHECK_EQ(flow_size(s, data, flow),
+             flow_size(s, data, basic_dinics_solver<int64_t>().solve(n, s, t, data)));
+}
+
+TEST_CASE("dense dinics on random graphs") {
+    int iterations = 2000;
+
+    while (iterations--) {
+        std::size_t n = std::uniform_int_distribution<std::size_t>(2, 40)(generator);
+        std::size_t m = std::uniform_int_distribution<std::size_t>(0, 2 * n * n)(generator);
+        int64_t max_capacity = iterations % 2 ? 1 : 100;
+        std::vector<capacity_edge<int64_t>> data;
+        for (std::size_t i = 0; i < m; ++i) {
+            data.emplace_back(std::uniform_int_distribution<std::size_t>(0, n - 1)(generator),
+                              std::uniform_int_distribution<std::size_t>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(0, max_capacity)(generator));
+        }
+        std::size_t s = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+        std::size_t t = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+        if (s == t) {
+            continue;
+        }
+
+        check_flow(n, s, t, data, dense_dinics_solver<int64_t>().solve(n, s, t, data));
+        check_flow(n, s, t, data, density_aware_solver<int64_t>().solve(n, s, t, data));
+    }
+}
+
+TEST_CASE("opposite edges cancel") {
+    std::vector<capacity_edge<int64_t>> data{{0, 1, 5}, {1, 2, 5}, {2, 1, 3}, {1, 2, 2}, {2, 3, 7}};
+
+    auto flow = dense_dinics_solver<int64_t>().solve(4, 0, 3, data);
+    check_flow(4, 0, 3, data, flow);
+    CHECK_EQ(flow_size(0, data, flow), 5);
+    CHECK_EQ(flow[2], 0);
+}
@@ -1,15 +1,26 @@
 #include <doctest.h>
 #include <random>
 
+#include "../dense_solvers.hpp"
 #include "../dinics_solvers.hpp"
+#include "../push_relabel_solvers.hpp"
+#include "../unit_capacity_solvers.hpp"
 
 using flows_coursework::capacity_edge;
 using flows_coursework::flows_solver;
+using flows_coursework::dense_solvers::dense_dinics_solver;
 using flows_coursework::dinics_solvers::basic_dinics_solver;
+using flows_coursework::dinics_solvers::hybrid_dinics_solver;
 using flows_coursework::dinics_solvers::linkcut_dinics_solver;
+using flows_coursework::dinics_solvers::mpm_dinics_solver;
 using flows_coursework::edmonds_solvers::edmonds_solver;
 using flows_coursework::dinics_solvers::scaled_dinics_solver;
+using flows_coursework::dinics_solvers::simple_splay_dynamic_tree;
+using flows_coursework::link_cut::naive_tree;
+using flows_coursework::push_relabel_solvers::dynamic_tree_push_relabel_solver;
+using flows_coursework::flows_utils::flow_graph;
 using flows_coursework::flows_utils::flow_size;
+using flows_coursework::unit_capacity_solvers::unit_capacity_solver;
 
 static std::mt19937 generator{42}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
@@ -19,7 +30,15 @@ std::vector<std::unique_ptr<flows_solver<T>>> all_solvers() {
     result.emplace_back(new basic_dinics_solver<T>);
     result.emplace_back(new edmonds_solver<T>);
     result.emplace_back(new linkcut_dinics_solver<T>);
+    result.emplace_back(new linkcut_dinics_solver<T, simple_splay_dynamic_tree<T>>);
+    result.emplace_back(new linkcut_dinics_solver<T, naive_tree<T>>);
+    result.emplace_back(new hybrid_dinics_solver<T>);
+    result.emplace_back(new hybrid_dinics_solver<T>(2, 1));
+    result.emplace_back(new dynamic_tree_push_relabel_solver<T>);
     result.emplace_back(new scaled_dinics_solver<T>);
+    result.emplace_back(new unit_capacity_solver<T>);
+    result.emplace_back(new dense_dinics_solver<T>);
+    result.emplace_back(new mpm_dinics_solver<T>);
     return result;
 }
 
@@ -209,3 +228,59 @@ TEST_CASE("akc hard maxflow test") {
     auto res = check_solvers_coincide(sz, s, t, data, all_solvers<int64_t>());
     CHECK_EQ(res, 2 * n + 3);
 }
+
+TEST_CASE("undirected flow value coincides with doubled edges") {
+    int n = 10;
+    int iterations = 500;
+
+    while (iterations--) {
+        std::vector<capacity_edge<int64_t>> data;
+        for (int i = 0; i < 3 * n; ++i) {
+            data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(0, 99)(generator));
+        }
+        auto doubled = data;
+        for (const auto &edge : data) {
+            doubled.emplace_back(edge.to, edge.from, edge.capacity);
+        }
+
+        auto expected =
+            flow_size(0, doubled, basic_dinics_solver<int64_t>().solve(n, 0, n - 1, doubled));
+        auto graph = flow_graph<int64_t>::undirected(n, 0, n - 1, data);
+        CHECK_EQ(basic_dinics_solver<int64_t>().flow_value(graph), expected);
+
+        // a limited flow stops at a value between the limit and the maximum
+        auto limited = basic_dinics_solver<int64_t>().flow_value(graph, expected / 2);
+        CHECK_LE(std::min(expected, expected / 2), limited);
+        CHECK_LE(limited, expected);
+    }
+}
+
+TEST_CASE("mpm blocking flows are feasible") {
+    int n = 12;
+    int iterations = 2000;
+
+    while (iterations--) {
+        std::vector<capacity_edge<int64_t>> data;
+        for (int i = 0; i < 4 * n; ++i) {
+            data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(0, 20)(generator));
+        }
+
+        auto res = mpm_dinics_solver<int64_t>().solve(n, 0, n - 1, data);
+        std::vector<int64_t> balance(n, 0);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            CHECK(res[i] >= 0);
+            CHECK(res[i] <= data[i].capacity);
+            balance[data[i].from] -= res[i];
+            balance[data[i].to] += res[i];
+        }
+        for (int v = 1; v + 1 < n; ++v) {
+            CHECK_EQ(balance[v], 0);
+        }
+        CHECK_EQ(flow_size(0, data, res),
+                 flow_size(0, data, basic_dinics_solver<int64_t>().solve(n, 0, n - 1, data)));
+    }
+}
@@ -1,9 +1,15 @@
 #include "../flows_utils.hpp"
 #include <cstdint>
 #include <doctest.h>
+#include <map>
+#include <random>
+#include <set>
 
 using flows_coursework::capacity_edge;
+using flows_coursework::flows_utils::contracted_edges;
+using flows_coursework::flows_utils::disjoint_sets;
 using flows_coursework::flows_utils::flow_graph;
+using flows_coursework::flows_utils::indexed_heap;
 
 
 TEST_CASE("push may push") {
@@ -43,3 +49,119 @@ TEST_CASE("push may push") {
         CHECK_EQ(fg.may_push(i, fg.get_edge_by_vertex(i, 0)), 50);
     }
 }
+
+TEST_CASE("indexed heap") {
+    std::mt19937 generator{7};
+    const std::size_t n = 1000;
+
+    indexed_heap<int64_t> heap(n);
+    std::set<std::pair<int64_t, std::size_t>> reference;
+
+    for (int step = 0; step < 100000; ++step) {
+        std::size_t vertex = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+        int64_t key = std::uniform_int_distribution<int64_t>(-1000, 1000)(generator);
+
+        if (!heap.contains(vertex)) {
+            heap.push(vertex, key);
+        } else if (step % 3 == 0) {
+            reference.erase({heap.key(vertex), vertex});
+            heap.update(vertex, key);
+        } else {
+            vertex = heap.top();
+            CHECK_EQ(heap.key(vertex), reference.rbegin()->first);
+            reference.erase({heap.key(vertex), vertex});
+            heap.pop();
+            CHECK_FALSE(heap.contains(vertex));
+            continue;
+        }
+        reference.emplace(key, vertex);
+        CHECK_EQ(heap.size(), reference.size());
+    }
+}
+
+TEST_CASE("disjoint sets") {
+    std::mt19937 generator{35};
+    const std::size_t n = 200;
+
+    disjoint_sets sets(n);
+    // naive reference: a set id per element
+    std::vector<std::size_t> ids(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        ids[i] = i;
+    }
+    std::size_t n_sets = n;
+
+    for (int step = 0; step < 2000; ++step) {
+        std::size_t u = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+        std::size_t v = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+
+        bool different = ids[u] != ids[v];
+        std::size_t root_u = sets.find(u);
+        CHECK_EQ(sets.unite(u, v), different);
+        if (different) {
+            std::size_t old_id = ids[v];
+            for (auto &id : ids) {
+                if (id == old_id) {
+                    id = ids[u];
+                }
+            }
+            --n_sets;
+            CHECK_EQ(sets.find(v), root_u);
+        }
+        CHECK_EQ(sets.sets_count(), n_sets);
+    }
+
+    auto labels = sets.labels();
+    std::size_t next_label = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            CHECK_EQ(labels[i] == labels[j], ids[i] == ids[j]);
+        }
+        if (labels[i] == next_label) {
+            ++next_label;
+        }
+        CHECK(labels[i] < next_label);
+    }
+    CHECK_EQ(next_label, n_sets);
+}
+
+TEST_CASE("contracted edges") {
+    std::mt19937 generator{36};
+
+    for (int iteration = 0; iteration < 100; ++iteration) {
+        std::size_t n = std::uniform_int_distribution<std::size_t>(1, 30)(generator);
+        std::size_t n_labels = std::uniform_int_distribution<std::size_t>(1, n)(generator);
+        std::vector<std::size_t> labels(n);
+        for (auto &label : labels) {
+            label = std::uniform_int_distribution<std::size_t>(0, n_labels - 1)(generator);
+        }
+
+        std::vector<capacity_edge<int64_t>> edges;
+        std::map<std::pair<std::size_t, std::size_t>, int64_t> expected;
+        for (std::size_t i = 0; i < 3 * n; ++i) {
+            std::size_t u = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+            std::size_t v = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+            int64_t capacity = std::uniform_int_distribution<int64_t>(0, 3)(generator);
+            edges.emplace_back(u, v, capacity);
+            if (labels[u] != labels[v]) {
+                expected[{std::min(labels[u], labels[v]), std::max(labels[u], labels[v])}] +=
+                    capacity;
+            }
+        }
+
+        std::map<std::pair<std::size_t, std::size_t>, int64_t> contracted;
+        std::size_t last_from = 0;
+        for (const auto &edge : contracted_edges(n_labels, edges, labels)) {
+            CHECK(edge.from < edge.to);
+            CHECK(edge.from >= last_from);
+            CHECK(edge.capacity > 0);
+            CHECK(contracted.count({edge.from, edge.to}) == 0);
+            contracted[{edge.from, edge.to}] = edge.capacity;
+            last_from = edge.from;
+        }
+        for (auto it = expected.begin(); it != expected.end();) {
+            it = it->second == 0 ? expected.erase(it) : std::next(it);
+        }
+        CHECK_EQ(contracted, expected);
+    }
+}
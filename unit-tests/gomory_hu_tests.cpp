@@ -0,0 +1,87 @@
+#include <cstdint>
+#include <doctest.h>
+#include <random>
+#include <vector>
+
+#include "../gomory_hu.hpp"
+#include "../stoer_wagner.hpp"
+
+using flows_coursework::capacity_edge;
+using flows_coursework::dinics_solvers::basic_dinics_solver;
+using flows_coursework::flows_utils::flow_size;
+using flows_coursework::undirected_cuts::cut_size;
+using flows_coursework::undirected_cuts::gomory_hu_tree;
+
+static std::mt19937 generator{41}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static std::vector<capacity_edge<int64_t>> random_graph(int n, int m) {
+    std::vector<capacity_edge<int64_t>> data;
+    for (int i = 0; i < m; ++i) {
+        data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                          std::uniform_int_distribution<int>(0, n - 1)(generator),
+                          std::uniform_int_distribution<int64_t>(0, 20)(generator));
+    }
+    return data;
+}
+
+TEST_CASE("path") {
+    int n = 50;
+
+    std::vector<capacity_edge<int64_t>> data;
+    for (int i = 0; i + 1 < n; ++i) {
+        data.emplace_back(i, i + 1, i % 7 + 1);
+    }
+
+    gomory_hu_tree<int64_t> tree(n, data);
+    for (int u = 0; u < n; ++u) {
+        for (int v = u + 1; v < n; ++v) {
+            int64_t expected = 7;
+            for (int i = u; i < v; ++i) {
+                expected = std::min<int64_t>(expected, i % 7 + 1);
+            }
+            CHECK_EQ(tree.mincut(u, v), expected);
+        }
+    }
+}
+
+TEST_CASE("all pairs stress with dinics") {
+    int iterations = 200;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 12)(generator);
+        auto data = random_graph(n, std::uniform_int_distribution<int>(1, 4 * n)(generator));
+        auto doubled = data;
+        for (const auto &edge : data) {
+            doubled.emplace_back(edge.to, edge.from, edge.capacity);
+        }
+
+        gomory_hu_tree<int64_t> tree(n, data, iterations % 4 + 1);
+        for (int u = 0; u < n; ++u) {
+            for (int v = 0; v < n; ++v) {
+                if (u == v) {
+                    continue;
+                }
+                auto expected =
+                    flow_size(u, doubled, basic_dinics_solver<int64_t>().solve(n, u, v, doubled));
+                CHECK_EQ(tree.mincut(u, v), expected);
+
+                auto side = tree.cut_side(u, v);
+                CHECK(side[u]);
+                CHECK_FALSE(side[v]);
+                CHECK_EQ(cut_size(data, side), expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("threads do not change the tree") {
+    int n = 300;
+    auto data = random_graph(n, 3 * n);
+
+    gomory_hu_tree<int64_t> sequential(n, data, 1);
+    gomory_hu_tree<int64_t> parallel(n, data, 8);
+    for (int v = 1; v < n; ++v) {
+        CHECK_EQ(sequential.parent(v), parallel.parent(v));
+        CHECK_EQ(sequential.parent_weight(v), parallel.parent_weight(v));
+    }
+}
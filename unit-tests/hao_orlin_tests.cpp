@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cstdint>
+#include <doctest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../push_relabel_solvers.hpp"
+
+using flows_coursework::capacity_edge;
+using flows_coursework::dinics_solvers::basic_dinics_solver;
+using flows_coursework::flows_utils::flow_size;
+using flows_coursework::push_relabel_solvers::hao_orlin_mincut_solver;
+
+static std::mt19937 generator{43}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static std::vector<capacity_edge<int64_t>> random_digraph(int n, int m, int64_t max_capacity) {
+    std::vector<capacity_edge<int64_t>> data;
+    for (int i = 0; i < m; ++i) {
+        data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                          std::uniform_int_distribution<int>(0, n - 1)(generator),
+                          std::uniform_int_distribution<int64_t>(0, max_capacity)(generator));
+    }
+    return data;
+}
+
+// weight of edges leaving the true side
+static int64_t directed_cut_size(const std::vector<capacity_edge<int64_t>> &data,
+                                 const std::vector<bool> &side) {
+    int64_t res = 0;
+    for (const auto &edge : data) {
+        if (side[edge.from] && !side[edge.to]) {
+            res += edge.capacity;
+        }
+    }
+    return res;
+}
+
+static void check_proper(const std::vector<bool> &side) {
+    bool has_true = false;
+    bool has_false = false;
+    for (bool value : side) {
+        has_true |= value;
+        has_false |= !value;
+    }
+    CHECK(has_true);
+    CHECK(has_false);
+}
+
+TEST_CASE("directed cycle with a chord") {
+    std::vector<capacity_edge<int64_t>> data{
+        {0, 1, 5},
+        {1, 2, 3},
+        {2, 3, 4},
+        {3, 0, 6},
+        {0, 2, 2}
+    };
+
+    auto side = hao_orlin_mincut_solver<int64_t>().find_mincut(4, data);
+    check_proper(side);
+    CHECK_EQ(directed_cut_size(data, side), 3);
+    CHECK_EQ(side, std::vector<bool>{false, true, false, false});
+}
+
+TEST_CASE("brute force over all cuts") {
+    int iterations = 1000;
+    hao_orlin_mincut_solver<int64_t> solver;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 8)(generator);
+        auto data = random_digraph(n, std::uniform_int_distribution<int>(0, 4 * n)(generator), 10);
+
+        int64_t expected = std::numeric_limits<int64_t>::max();
+        for (unsigned mask = 1; mask + 1 < (1U << n); ++mask) {
+            std::vector<bool> side(n);
+            for (int v = 0; v < n; ++v) {
+                side[v] = (mask >> v) & 1U;
+            }
+            expected = std::min(expected, directed_cut_size(data, side));
+        }
+
+        auto side = solver.find_mincut(n, data);
+        check_proper(side);
+        CHECK_EQ(directed_cut_size(data, side), expected);
+    }
+}
+
+TEST_CASE("stress with dinics") {
+    int iterations = 20;
+    hao_orlin_mincut_solver<int64_t> solver;
+
+    while (iterations--) {
+        int n = 60;
+        auto data = random_digraph(n, 6 * n, 100);
+
+        int64_t expected = std::numeric_limits<int64_t>::max();
+        for (int t = 1; t < n; ++t) {
+            auto forward = basic_dinics_solver<int64_t>().solve(n, 0, t, data);
+            auto backward = basic_dinics_solver<int64_t>().solve(n, t, 0, data);
+            expected =
+                std::min({expected, flow_size(0, data, forward), flow_size(t, data, backward)});
+        }
+
+        auto side = solver.find_mincut(n, data);
+        check_proper(side);
+        CHECK_EQ(directed_cut_size(data, side), expected);
+    }
+}
+
+TEST_CASE("sinks next to the sources") {
+    int iterations = 300;
+    hao_orlin_mincut_solver<int64_t> solver;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 8)(generator);
+        auto data = random_digraph(n, std::uniform_int_distribution<int>(0, 4 * n)(generator), 3);
+
+        int64_t expected = std::numeric_limits<int64_t>::max();
+        for (unsigned mask = 1; mask + 1 < (1U << n); mask += 2) {
+            std::vector<bool> side(n);
+            for (int v = 0; v < n; ++v) {
+                side[v] = (mask >> v) & 1U;
+            }
+            expected = std::min(expected, directed_cut_size(data, side));
+        }
+
+        std::vector<bool> sources(n);
+        sources[0] = true;
+        int64_t found = std::numeric_limits<int64_t>::max();
+        solver.run_adjacent(n, data, [&]() {
+            bool has_edge = false;
+            bool any_edge = false;
+            for (const auto &edge : data) {
+                if (sources[edge.from] && !sources[edge.to] && edge.capacity > 0) {
+                    any_edge = true;
+                    has_edge |= edge.to == solver.sink();
+                }
+            }
+            CHECK_EQ(has_edge, any_edge);
+            found = std::min(found, solver.excess(solver.sink()));
+            sources[solver.sink()] = true;
+        });
+        CHECK_EQ(found, expected);
+    }
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <cstdint>
+#include <doctest.h>
+#include <random>
+#include <vector>
+
+#include "../incremental_mincut.hpp"
+#include "../stoer_wagner.hpp"
+
+using flows_coursework::capacity_edge;
+using flows_coursework::undirected_cuts::cut_size;
+using flows_coursework::undirected_cuts::global_mincut_size_wagner;
+using flows_coursework::undirected_cuts::incremental_mincut;
+
+static std::mt19937 generator{45}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static capacity_edge<int64_t> random_edge(int n, int64_t max_capacity) {
+    return {std::uniform_int_distribution<std::size_t>(0, n - 1)(generator),
+            std::uniform_int_distribution<std::size_t>(0, n - 1)(generator),
+            std::uniform_int_distribution<int64_t>(1, max_capacity)(generator)};
+}
+
+static void check_cut(const incremental_mincut<int64_t> &mincut,
+                      const std::vector<capacity_edge<int64_t>> &data) {
+    const auto &side = mincut.mincut_side();
+    CHECK_FALSE(side[0]);
+    CHECK(std::find(side.begin(), side.end(), true) != side.end());
+    CHECK_EQ(cut_size(data, side), mincut.mincut_value());
+    CHECK_EQ(mincut.mincut_value(), global_mincut_size_wagner<int64_t>(mincut.size(), data));
+}
+
+TEST_CASE("growing from an empty graph") {
+    int n = 6;
+
+    std::vector<capacity_edge<int64_t>> data;
+    incremental_mincut<int64_t> mincut(n, data);
+    CHECK_EQ(mincut.mincut_value(), 0);
+    for (int v = 0; v + 1 < n; ++v) {
+        data.emplace_back(v, v + 1, 2);
+        mincut.add_edge(v, v + 1, 2);
+        check_cut(mincut, data);
+    }
+    CHECK_EQ(mincut.mincut_value(), 2);
+
+    data.emplace_back(n - 1, 0, 3);
+    mincut.add_edge(n - 1, 0, 3);
+    check_cut(mincut, data);
+    CHECK_EQ(mincut.mincut_value(), 4);
+}
+
+TEST_CASE("stress with stoer wagner") {
+    int iterations = 100;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 15)(generator);
+        int64_t max_capacity = iterations % 3 + 1;
+        std::vector<capacity_edge<int64_t>> data;
+        for (int i = std::uniform_int_distribution<int>(0, 2 * n)(generator); i > 0; --i) {
+            data.push_back(random_edge(n, max_capacity));
+        }
+
+        incremental_mincut<int64_t> mincut(n, data);
+        check_cut(mincut, data);
+        for (int i = 0; i < 4 * n; ++i) {
+            data.push_back(random_edge(n, max_capacity));
+            mincut.add_edge(data.back().from, data.back().to, data.back().capacity);
+            check_cut(mincut, data);
+        }
+    }
+}
+
+TEST_CASE("few rebuilds on a growing cycle") {
+    int n = 100;
+
+    // every pair of cycle edges is a minimum cut, chords only drop some of them
+    std::vector<capacity_edge<int64_t>> data;
+    for (int v = 0; v < n; ++v) {
+        data.emplace_back(v, (v + 1) % n, 1);
+    }
+    incremental_mincut<int64_t> mincut(n, data);
+    for (int v = 0; v + 10 < n; v += 10) {
+        data.emplace_back(v, v + 10, 1);
+        mincut.add_edge(v, v + 10, 1);
+        check_cut(mincut, data);
+    }
+    CHECK_EQ(mincut.mincut_value(), 2);
+    CHECK_EQ(mincut.rebuilds_count(), 1);
+}
+
+TEST_CASE("many cuts on a long cycle") {
+    int n = 2000;
+
+    // n (n - 1) / 2 minimum cuts, too many to copy, walked in the cactus instead
+    std::vector<capacity_edge<int64_t>> data;
+    for (int v = 0; v < n; ++v) {
+        data.emplace_back(v, (v + 1) % n, 1);
+    }
+    incremental_mincut<int64_t> mincut(n, data);
+    for (int v = 0; v + n / 2 < n; v += n / 20) {
+        data.emplace_back(v, v + n / 2, 1);
+        mincut.add_edge(v, v + n / 2, 1);
+        CHECK_EQ(cut_size(data, mincut.mincut_side()), 2);
+    }
+    CHECK_EQ(mincut.mincut_value(), 2);
+    CHECK_EQ(mincut.rebuilds_count(), 1);
+}
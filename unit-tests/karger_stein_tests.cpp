@@ -0,0 +1,68 @@
+#include <cstdint>
+#include <doctest.h>
+#include <random>
+#include <vector>
+
+#include "../karger_stein.hpp"
+
+using flows_coursework::capacity_edge;
+using flows_coursework::undirected_cuts::cut_size;
+using flows_coursework::undirected_cuts::global_mincut_size_dinics;
+using flows_coursework::undirected_cuts::global_mincut_size_wagner;
+using flows_coursework::undirected_cuts::karger_stein_mincut_solver;
+
+static std::mt19937 generator{37}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static std::vector<capacity_edge<int64_t>> random_graph(int n, int m) {
+    std::vector<capacity_edge<int64_t>> data;
+    for (int i = 0; i < m; ++i) {
+        data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                          std::uniform_int_distribution<int>(0, n - 1)(generator),
+                          std::uniform_int_distribution<int64_t>(0, 20)(generator));
+    }
+    return data;
+}
+
+TEST_CASE("stress with dinics") {
+    int iterations = 100;
+
+    // contractions go down to 6 vertices, so the recursion does most of the work
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 40)(generator);
+        auto data = random_graph(n, std::uniform_int_distribution<int>(1, 5 * n)(generator));
+
+        auto cut = karger_stein_mincut_solver<int64_t>(0.9999, iterations, 1, 6)
+                       .find_mincut(n, data);
+        CHECK_EQ(cut_size(data, cut), global_mincut_size_dinics(n, data));
+    }
+}
+
+TEST_CASE("stress above the exact base") {
+    int iterations = 30;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(40, 100)(generator);
+        auto data = random_graph(n, std::uniform_int_distribution<int>(2 * n, 6 * n)(generator));
+
+        auto cut = karger_stein_mincut_solver<int64_t>(0.999999, iterations).find_mincut(n, data);
+        CHECK_EQ(cut_size(data, cut), global_mincut_size_wagner(n, data));
+    }
+}
+
+TEST_CASE("same seed gives same cut") {
+    int n = 60;
+
+    std::vector<capacity_edge<int64_t>> data;
+    for (int i = 0; i < 8 * n; ++i) {
+        data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                          std::uniform_int_distribution<int>(0, n - 1)(generator),
+                          std::uniform_int_distribution<int64_t>(1, 100)(generator));
+    }
+
+    auto single_thread = karger_stein_mincut_solver<int64_t>(0.9, 5, 1).find_mincut(n, data);
+    auto many_threads = karger_stein_mincut_solver<int64_t>(0.9, 5, 4).find_mincut(n, data);
+    CHECK_EQ(single_thread, many_threads);
+
+    auto precise = karger_stein_mincut_solver<int64_t>(0.9999, 5).find_mincut(n, data);
+    CHECK_EQ(cut_size(data, precise), global_mincut_size_wagner(n, data));
+}
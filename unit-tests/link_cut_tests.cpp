@@ -1,11 +1,19 @@
 #include "../link_cut.hpp"
 #include <cstdint>
+#include <cstdlib>
 #include <doctest.h>
 #include <random>
 #include <algorithm>
 #include <utility>
 
+using flows_coursework::link_cut::add_update;
+using flows_coursework::link_cut::affine_update;
+using flows_coursework::link_cut::EVERT;
 using flows_coursework::link_cut::link_cut;
+using flows_coursework::link_cut::max_aggregate;
+using flows_coursework::link_cut::min_aggregate;
+using flows_coursework::link_cut::NO_OPTIONS;
+using flows_coursework::link_cut::sum_aggregate;
 
 static std::mt19937 generator{42}; //NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
@@ -476,3 +484,354 @@ TEST_CASE("stress on path") {
     }
 }
 
+
+TEST_CASE("sum with affine updates on path") {
+    std::vector<uint64_t> data(100);
+    link_cut<uint64_t, sum_aggregate<uint64_t>, affine_update<uint64_t>, NO_OPTIONS> lc(100);
+
+    std::uniform_int_distribution<std::size_t> vert_distribution(0, 99);
+    std::uniform_int_distribution<uint64_t> val_distribution(0, 9);
+    std::uniform_int_distribution<int> op_distribution(0, 2);
+
+    for (int i = 0; i < 99; ++i) {
+        lc.link_cut_link(i, i + 1);
+    }
+
+    for (int j = 0; j < 100'000; ++j) {
+        std::size_t vert_lo = vert_distribution(generator);
+        std::size_t vert_hi = vert_distribution(generator);
+        if (vert_hi < vert_lo) {
+            std::swap(vert_hi, vert_lo);
+        }
+
+        if (vert_hi < 99) {
+            lc.link_cut_cut(vert_hi);
+        }
+
+        switch (op_distribution(generator)) {
+        case 0: { // affine on seg
+            uint64_t multiplier = val_distribution(generator);
+            uint64_t addend = val_distribution(generator);
+            for (std::size_t i = vert_lo; i <= vert_hi; ++i) {
+                data[i] = multiplier * data[i] + addend;
+            }
+            lc.link_cut_update_on_path(vert_lo, {multiplier, addend});
+            break;
+        }
+        case 1: { // sum on seg
+            uint64_t res = 0;
+            for (std::size_t i = vert_lo; i <= vert_hi; ++i) {
+                res += data[i];
+            }
+            CHECK_EQ(res, lc.link_cut_get_on_path(vert_lo));
+            break;
+        }
+        case 2: { // get
+            CHECK_EQ(data[vert_lo], lc.link_cut_get(vert_lo));
+            break;
+        }
+        }
+
+        if (vert_hi < 99) {
+            lc.link_cut_link(vert_hi, vert_hi + 1);
+        }
+    }
+}
+
+TEST_CASE("max with add on path") {
+    std::vector<int64_t> data(100);
+    link_cut<int64_t, max_aggregate<int64_t>, add_update<int64_t>, NO_OPTIONS> lc(100);
+
+    std::uniform_int_distribution<std::size_t> vert_distribution(0, 99);
+    std::uniform_int_distribution<int64_t> val_distribution(-9, 9);
+
+    for (int i = 0; i < 99; ++i) {
+        lc.link_cut_link(i, i + 1);
+    }
+
+    for (int j = 0; j < 100'000; ++j) {
+        std::size_t vert_lo = vert_distribution(generator);
+        std::size_t vert_hi = vert_distribution(generator);
+        int64_t val = val_distribution(generator);
+        if (vert_hi < vert_lo) {
+            std::swap(vert_hi, vert_lo);
+        }
+
+        if (vert_hi < 99) {
+            lc.link_cut_cut(vert_hi);
+        }
+
+        if (j % 2) {
+            for (std::size_t i = vert_lo; i <= vert_hi; ++i) {
+                data[i] += val;
+            }
+            lc.link_cut_add_on_path(vert_lo, val);
+        } else {
+            auto result = lc.link_cut_get_on_path(vert_lo);
+            CHECK_EQ(result.result, data[result.node]);
+            CHECK_EQ(result.result,
+                     *std::max_element(data.begin() + vert_lo, data.begin() + vert_hi + 1));
+        }
+
+        if (vert_hi < 99) {
+            lc.link_cut_link(vert_hi, vert_hi + 1);
+        }
+    }
+}
+
+// vertices of the path from to back to from in an undirected forest, empty if there is none
+static std::vector<std::size_t> tree_path(const std::vector<std::vector<std::size_t>> &adjacent,
+                                          std::size_t from, std::size_t to) {
+    std::size_t n = adjacent.size();
+    std::vector<std::size_t> previous(n, n);
+    std::vector<std::size_t> stack{from};
+    previous[from] = from;
+    while (!stack.empty()) {
+        std::size_t current = stack.back();
+        stack.pop_back();
+        for (auto next : adjacent[current]) {
+            if (previous[next] == n) {
+                previous[next] = current;
+                stack.push_back(next);
+            }
+        }
+    }
+
+    std::vector<std::size_t> path;
+    if (previous[to] != n) {
+        for (std::size_t current = to; current != from; current = previous[current]) {
+            path.push_back(current);
+        }
+        path.push_back(from);
+    }
+    return path;
+}
+
+TEST_CASE("undirected forest with evert") {
+    const std::size_t n = 30;
+    link_cut<int64_t, sum_aggregate<int64_t>, add_update<int64_t>, EVERT> lc(n);
+    std::vector<int64_t> data(n);
+    std::vector<std::vector<std::size_t>> adjacent(n);
+
+    std::uniform_int_distribution<std::size_t> vert_distribution(0, n - 1);
+    std::uniform_int_distribution<int64_t> val_distribution(-9, 9);
+    std::uniform_int_distribution<int> op_distribution(0, 3);
+
+    for (int j = 0; j < 200'000; ++j) {
+        std::size_t u = vert_distribution(generator);
+        std::size_t v = vert_distribution(generator);
+        auto path = tree_path(adjacent, u, v);
+        CHECK_EQ(lc.link_cut_connected(u, v), !path.empty());
+
+        switch (op_distribution(generator)) {
+        case 0: { // link or cut
+            if (path.empty()) {
+                lc.link_cut_connect(u, v);
+                adjacent[u].push_back(v);
+                adjacent[v].push_back(u);
+            } else if (path.size() == 2) {
+                lc.link_cut_disconnect(u, v);
+                adjacent[u].erase(std::find(adjacent[u].begin(), adjacent[u].end(), v));
+                adjacent[v].erase(std::find(adjacent[v].begin(), adjacent[v].end(), u));
+            }
+            break;
+        }
+        case 1: { // add on path
+            int64_t val = val_distribution(generator);
+            if (!path.empty()) {
+                for (auto vert : path) {
+                    data[vert] += val;
+                }
+                lc.link_cut_update_on_path(u, v, val);
+            }
+            break;
+        }
+        case 2: { // sum on path
+            if (!path.empty()) {
+                int64_t res = 0;
+                for (auto vert : path) {
+                    res += data[vert];
+                }
+                CHECK_EQ(res, lc.link_cut_get_on_path(u, v));
+            }
+            break;
+        }
+        case 3: { // reroot and check parent
+            lc.link_cut_evert(u);
+            CHECK_EQ(lc.link_cut_parent(u), std::nullopt);
+            if (path.size() >= 2) {
+                CHECK_EQ(lc.link_cut_root(v), u);
+                CHECK_EQ(lc.link_cut_parent(v), path[1]);
+            }
+            CHECK_EQ(lc.link_cut_get(v), data[v]);
+            break;
+        }
+        }
+    }
+}
+
+TEST_CASE("min with ties after evert") {
+    const std::size_t n = 20;
+    link_cut<int64_t, min_aggregate<int64_t>, add_update<int64_t>, EVERT> lc(n);
+    std::vector<int64_t> data(n);
+    std::vector<std::vector<std::size_t>> adjacent(n);
+
+    std::uniform_int_distribution<std::size_t> vert_distribution(0, n - 1);
+    std::uniform_int_distribution<int64_t> val_distribution(-1, 1);
+    std::uniform_int_distribution<int> op_distribution(0, 3);
+
+    for (int j = 0; j < 100'000; ++j) {
+        std::size_t u = vert_distribution(generator);
+        std::size_t v = vert_distribution(generator);
+        auto path = tree_path(adjacent, u, v);
+
+        switch (op_distribution(generator)) {
+        case 0: { // link or cut
+            if (path.empty()) {
+                lc.link_cut_connect(u, v);
+                adjacent[u].push_back(v);
+                adjacent[v].push_back(u);
+            } else if (path.size() == 2 && j % 3 == 0) {
+                lc.link_cut_disconnect(u, v);
+                adjacent[u].erase(std::find(adjacent[u].begin(), adjacent[u].end(), v));
+                adjacent[v].erase(std::find(adjacent[v].begin(), adjacent[v].end(), u));
+            }
+            break;
+        }
+        case 1: { // add on path, small values keep many ties
+            int64_t val = val_distribution(generator);
+            if (!path.empty() && std::abs(data[u] + val) <= 1) {
+                for (auto vert : path) {
+                    data[vert] += val;
+                }
+                lc.link_cut_update_on_path(u, v, val);
+            }
+            break;
+        }
+        case 2: { // reroot somewhere else, so the next query reverses paths
+            lc.link_cut_evert(v);
+            break;
+        }
+        case 3: { // min on path from u to v, ties go to the vertex nearest to v
+            if (!path.empty()) {
+                auto nearest = *std::min_element(
+                    path.begin(), path.end(),
+                    [&](std::size_t lhs, std::size_t rhs) { return data[lhs] < data[rhs]; });
+                auto [vertex, value] = lc.link_cut_get_min_on_path(u, v);
+                CHECK_EQ(value, data[nearest]);
+                CHECK_EQ(vertex, nearest);
+            }
+            break;
+        }
+        }
+    }
+}
+
+TEST_CASE("batch coincides with sequential application") {
+    using tree_t = link_cut<int64_t>;
+    using flows_coursework::link_cut::naive_tree;
+    using flows_coursework::link_cut::operation_type;
+
+    const std::size_t n = 2000;
+    tree_t lc(n);
+    naive_tree<int64_t> expected(n);
+
+    std::uniform_int_distribution<std::size_t> vert_distribution(0, n - 1);
+    std::uniform_int_distribution<int64_t> val_distribution(-9, 9);
+    std::uniform_int_distribution<int> op_distribution(0, 6);
+
+    for (int batch = 0; batch < 50; ++batch) {
+        std::vector<tree_t::operation> operations;
+        std::vector<tree_t::operation_result> results;
+
+        for (int j = 0; j < 2000; ++j) {
+            tree_t::operation op;
+            tree_t::operation_result result;
+            op.node = vert_distribution(generator);
+            op.data = val_distribution(generator);
+            op.tag = op.data;
+
+            switch (op_distribution(generator)) {
+            case 0:
+            case 1:
+                op.parent = vert_distribution(generator);
+                if (expected.link_cut_parent(op.node).has_value() ||
+                    expected.link_cut_root(op.parent) == op.node) {
+                    continue;
+                }
+                op.type = operation_type::LINK;
+                expected.link_cut_link(op.node, op.parent);
+                break;
+            case 2:
+                if (!expected.link_cut_parent(op.node).has_value()) {
+                    continue;
+                }
+                op.type = operation_type::CUT;
+                expected.link_cut_cut(op.node);
+                break;
+            case 3:
+                op.type = operation_type::ROOT;
+                result.vertex = expected.link_cut_root(op.node);
+                break;
+            case 4:
+                op.type = operation_type::ADD;
+                expected.link_cut_add(op.node, op.data);
+                break;
+            case 5:
+                op.type = operation_type::UPDATE_ON_PATH;
+                expected.link_cut_add_on_path(op.node, op.data);
+                break;
+            case 6:
+                op.type = operation_type::GET_ON_PATH;
+                result.aggregate.node = expected.link_cut_get_min_on_path(op.node).first;
+                result.aggregate.result = expected.link_cut_get_min_on_path(op.node).second;
+                break;
+            }
+            operations.push_back(op);
+            results.push_back(result);
+        }
+
+        auto batch_results = lc.link_cut_apply_batch(operations, 4);
+        REQUIRE(batch_results.has_value());
+        for (std::size_t i = 0; i < operations.size(); ++i) {
+            if (operations[i].type == operation_type::ROOT) {
+                CHECK_EQ((*batch_results)[i].vertex, results[i].vertex);
+            } else if (operations[i].type == operation_type::GET_ON_PATH) {
+                CHECK_EQ((*batch_results)[i].aggregate.result, results[i].aggregate.result);
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        CHECK_EQ(lc.link_cut_get(i), expected.link_cut_get(i));
+        CHECK_EQ(lc.link_cut_parent(i), expected.link_cut_parent(i));
+    }
+}
+
+TEST_CASE("batch rejects path operations without policies") {
+    using flows_coursework::link_cut::no_aggregate;
+    using flows_coursework::link_cut::no_update;
+    using flows_coursework::link_cut::operation_type;
+    using plain_t = link_cut<int64_t, no_aggregate<int64_t>, no_update<int64_t>>;
+    using update_only_t = link_cut<int64_t, no_aggregate<int64_t>, add_update<int64_t>>;
+
+    plain_t plain(3);
+    std::vector<plain_t::operation> operations{{operation_type::LINK, 1, 0},
+                                               {operation_type::SET, 2, 0, 5},
+                                               {operation_type::UPDATE_ON_PATH, 1, 0, 0, 1}};
+    CHECK_FALSE(plain.link_cut_apply_batch(operations).has_value());
+    CHECK(plain.link_cut_apply_batch({}).has_value());
+    CHECK_FALSE(plain.link_cut_parent(1).has_value());
+    CHECK_EQ(plain.link_cut_get(2), 0);
+    operations.pop_back();
+    CHECK_EQ(plain.link_cut_apply_batch(operations)->size(), 2);
+    CHECK_EQ(plain.link_cut_parent(1), 0);
+
+    update_only_t update_only(2);
+    std::vector<update_only_t::operation> updates{{operation_type::UPDATE_ON_PATH, 1, 0, 0, 4}};
+    CHECK_EQ(update_only.link_cut_apply_batch(updates)->size(), 1);
+    CHECK_EQ(update_only.link_cut_get(1), 4);
+    updates.push_back({operation_type::GET_ON_PATH, 1});
+    CHECK_FALSE(update_only.link_cut_apply_batch(updates).has_value());
+    CHECK_EQ(update_only.link_cut_get(1), 4);
+}
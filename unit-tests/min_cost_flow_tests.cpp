@@ -0,0 +1,185 @@
+#include <cstdint>
+#include <doctest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../dinics_solvers.hpp"
+#include "../min_cost_flow.hpp"
+
+using flows_coursework::capacity_edge;
+using flows_coursework::cost_edge;
+using flows_coursework::dinics_solvers::basic_dinics_solver;
+using flows_coursework::flows_utils::flow_size;
+using flows_coursework::min_cost_flows::cost_scaling_solver;
+using flows_coursework::min_cost_flows::successive_shortest_paths_solver;
+
+static std::mt19937 generator{46}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+// edges go from smaller to larger vertices when costs may be negative, so there are no cycles
+static std::vector<cost_edge<int64_t>> random_network(int n, int m, bool acyclic) {
+    std::vector<cost_edge<int64_t>> data;
+    for (int i = 0; i < m; ++i) {
+        int u = std::uniform_int_distribution<int>(0, n - 1)(generator);
+        int v = std::uniform_int_distribution<int>(0, n - 1)(generator);
+        if (acyclic && u >= v) {
+            continue;
+        }
+        data.emplace_back(u, v, std::uniform_int_distribution<int64_t>(0, 10)(generator),
+                          std::uniform_int_distribution<int64_t>(acyclic ? -10 : 0, 20)(generator));
+    }
+    return data;
+}
+
+// A flow is cheapest among flows of its value iff no residual cycle has negative cost
+static bool has_negative_residual_cycle(int n, const std::vector<cost_edge<int64_t>> &data,
+                                        const std::vector<int64_t> &flow) {
+    std::vector<int64_t> distances(n, 0);
+    for (int round = 0; round <= n; ++round) {
+        bool changed = false;
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            const auto &edge = data[i];
+            if (flow[i] < edge.capacity && distances[edge.from] + edge.cost < distances[edge.to]) {
+                distances[edge.to] = distances[edge.from] + edge.cost;
+                changed = true;
+            }
+            if (flow[i] > 0 && distances[edge.to] - edge.cost < distances[edge.from]) {
+                distances[edge.from] = distances[edge.to] - edge.cost;
+                changed = true;
+            }
+        }
+        if (!changed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Solver>
+static void check_flow(int n, int s, int t, const std::vector<cost_edge<int64_t>> &data,
+                       const std::vector<int64_t> &flow, const Solver &solver) {
+    std::vector<int64_t> balance(n, 0);
+    int64_t cost = 0;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        CHECK(flow[i] >= 0);
+        CHECK(flow[i] <= data[i].capacity);
+        balance[data[i].from] -= flow[i];
+        balance[data[i].to] += flow[i];
+        cost += flow[i] * data[i].cost;
+    }
+    for (int v = 0; v < n; ++v) {
+        if (v != s && v != t) {
+            CHECK_EQ(balance[v], 0);
+        }
+    }
+    std::vector<capacity_edge<int64_t>> base(data.begin(), data.end());
+    CHECK_EQ(flow_size<int64_t>(s, base, flow), solver.flow_value());
+    CHECK_EQ(cost, solver.cost());
+    CHECK_FALSE(has_negative_residual_cycle(n, data, flow));
+}
+
+TEST_CASE("cheaper long path") {
+    std::vector<cost_edge<int64_t>> data{
+        {0, 3, 2, 10}, {0, 1, 3, 1}, {1, 2, 2, 1}, {2, 3, 3, 1}, {1, 3, 1, 5}};
+
+    successive_shortest_paths_solver<int64_t> solver;
+    auto flow = solver.solve(4, 0, 3, data);
+    CHECK_EQ(solver.flow_value(), 5);
+    CHECK_EQ(solver.cost(), 2 * 10 + 2 * 3 + 1 * 6);
+    check_flow(4, 0, 3, data, flow, solver);
+
+    flow = solver.solve(4, 0, 3, data, 2);
+    CHECK_EQ(solver.flow_value(), 2);
+    CHECK_EQ(solver.cost(), 6);
+    check_flow(4, 0, 3, data, flow, solver);
+}
+
+TEST_CASE("maximum flow with dinics") {
+    int iterations = 300;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 30)(generator);
+        bool acyclic = iterations % 2;
+        auto data = random_network(n, std::uniform_int_distribution<int>(1, 5 * n)(generator),
+                                   acyclic);
+        int s = acyclic ? 0 : std::uniform_int_distribution<int>(0, n - 1)(generator);
+        int t = acyclic ? n - 1 : std::uniform_int_distribution<int>(0, n - 1)(generator);
+        if (s == t) {
+            continue;
+        }
+
+        successive_shortest_paths_solver<int64_t> solver;
+        auto flow = solver.solve(n, s, t, data);
+        std::vector<capacity_edge<int64_t>> base(data.begin(), data.end());
+        CHECK_EQ(solver.flow_value(),
+                 flow_size<int64_t>(s, base, basic_dinics_solver<int64_t>().solve(n, s, t, base)));
+        check_flow(n, s, t, data, flow, solver);
+    }
+}
+
+TEST_CASE("costs of every flow value are convex") {
+    int iterations = 50;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 15)(generator);
+        auto data = random_network(n, 4 * n, true);
+
+        successive_shortest_paths_solver<int64_t> solver;
+        solver.solve(n, 0, n - 1, data);
+        int64_t max_flow = solver.flow_value();
+
+        int64_t previous_cost = 0;
+        int64_t previous_step = std::numeric_limits<int64_t>::min();
+        for (int64_t value = 0; value <= max_flow; ++value) {
+            auto flow = solver.solve(n, 0, n - 1, data, value);
+            CHECK_EQ(solver.flow_value(), value);
+            check_flow(n, 0, n - 1, data, flow, solver);
+            if (value > 0) {
+                CHECK(solver.cost() - previous_cost >= previous_step);
+                previous_step = solver.cost() - previous_cost;
+            }
+            previous_cost = solver.cost();
+        }
+    }
+}
+
+TEST_CASE("cost scaling agrees with successive shortest paths") {
+    int iterations = 300;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 30)(generator);
+        bool acyclic = iterations % 2;
+        auto data = random_network(n, std::uniform_int_distribution<int>(1, 5 * n)(generator),
+                                   acyclic);
+        int s = acyclic ? 0 : std::uniform_int_distribution<int>(0, n - 1)(generator);
+        int t = acyclic ? n - 1 : std::uniform_int_distribution<int>(0, n - 1)(generator);
+        if (s == t) {
+            continue;
+        }
+
+        successive_shortest_paths_solver<int64_t> expected;
+        expected.solve(n, s, t, data);
+        cost_scaling_solver<int64_t> solver;
+        auto flow = solver.solve(n, s, t, data);
+        CHECK_EQ(solver.flow_value(), expected.flow_value());
+        CHECK_EQ(solver.cost(), expected.cost());
+        check_flow(n, s, t, data, flow, solver);
+
+        int64_t value = std::uniform_int_distribution<int64_t>(0, expected.flow_value())(generator);
+        expected.solve(n, s, t, data, value);
+        flow = solver.solve(n, s, t, data, value);
+        CHECK_EQ(solver.flow_value(), value);
+        CHECK_EQ(solver.cost(), expected.cost());
+        check_flow(n, s, t, data, flow, solver);
+    }
+}
+
+TEST_CASE("cost scaling cancels negative cycles") {
+    std::vector<cost_edge<int64_t>> data{{0, 1, 2, 3}, {1, 3, 2, 3}, {1, 2, 3, -1}, {2, 1, 3, -1}};
+
+    cost_scaling_solver<int64_t> solver;
+    auto flow = solver.solve(4, 0, 3, data);
+    CHECK_EQ(solver.flow_value(), 2);
+    CHECK_EQ(solver.cost(), 2 * 6 - 6);
+    check_flow(4, 0, 3, data, flow, solver);
+}
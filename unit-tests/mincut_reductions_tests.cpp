@@ -0,0 +1,118 @@
+#include <cstdint>
+#include <doctest.h>
+#include <random>
+#include <vector>
+
+#include "../mincut_reductions.hpp"
+
+using flows_coursework::capacity_edge;
+using flows_coursework::undirected_cuts::certified_mincut;
+using flows_coursework::undirected_cuts::cut_size;
+using flows_coursework::undirected_cuts::global_mincut_size_certified_dinics;
+using flows_coursework::undirected_cuts::global_mincut_size_dinics;
+using flows_coursework::undirected_cuts::kernelized_mincut;
+using flows_coursework::undirected_cuts::matula_mincut_approximator;
+using flows_coursework::undirected_cuts::padberg_rinaldi_kernelizer;
+using flows_coursework::undirected_cuts::sparse_certificate;
+
+static std::mt19937 generator{33}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+TEST_CASE("two cliques shrink to an edge") {
+    int n = 30;
+
+    std::vector<capacity_edge<int64_t>> data;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < i; ++j) {
+            data.emplace_back(i, j, 1);
+            data.emplace_back(n + i, n + j, 1);
+        }
+    }
+    data.emplace_back(0, n, 3);
+    data.emplace_back(1, n + 1, 2);
+
+    auto kernel = padberg_rinaldi_kernelizer<int64_t>().kernelize(2 * n, data);
+    CHECK_LE(kernel.n_vertices, 2);
+
+    auto cut = kernelized_mincut(2 * n, data);
+    CHECK_EQ(cut_size(data, cut), 5);
+    for (int i = 1; i < n; ++i) {
+        CHECK_EQ(cut[i], cut[0]);
+        CHECK_EQ(cut[n + i], cut[n]);
+    }
+}
+
+TEST_CASE("stress with dinics") {
+    int iterations = 1000;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 10)(generator);
+        int m = std::uniform_int_distribution<int>(1, 5 * n)(generator);
+        int64_t max_capacity = std::uniform_int_distribution<int64_t>(1, 20)(generator);
+
+        std::vector<capacity_edge<int64_t>> data;
+        for (int i = 0; i < m; ++i) {
+            data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(0, max_capacity)(generator));
+        }
+
+        CHECK_EQ(cut_size(data, kernelized_mincut(n, data)), global_mincut_size_dinics(n, data));
+    }
+}
+
+TEST_CASE("certificate keeps light cuts") {
+    int iterations = 1000;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 10)(generator);
+        int m = std::uniform_int_distribution<int>(1, 5 * n)(generator);
+        int64_t k = std::uniform_int_distribution<int64_t>(1, 50)(generator);
+
+        std::vector<capacity_edge<int64_t>> data;
+        for (int i = 0; i < m; ++i) {
+            data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(0, 20)(generator));
+        }
+
+        auto certificate = sparse_certificate<int64_t>(n, data, k);
+        int64_t total = 0;
+        for (const auto &edge : certificate) {
+            total += edge.capacity;
+        }
+        CHECK_LE(total, k * (n - 1));
+
+        for (int mask = 1; mask + 1 < (1 << n); ++mask) {
+            std::vector<bool> cut(n);
+            for (int i = 0; i < n; ++i) {
+                cut[i] = (mask >> i) & 1;
+            }
+            CHECK_EQ(std::min(cut_size(certificate, cut), k), std::min(cut_size(data, cut), k));
+        }
+
+        CHECK_EQ(cut_size(data, certified_mincut(n, data)), global_mincut_size_dinics(n, data));
+        CHECK_EQ(global_mincut_size_certified_dinics(n, data), global_mincut_size_dinics(n, data));
+    }
+}
+
+TEST_CASE("matula approximation") {
+    int iterations = 1000;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 10)(generator);
+        int m = std::uniform_int_distribution<int>(1, 5 * n)(generator);
+
+        std::vector<capacity_edge<int64_t>> data;
+        for (int i = 0; i < m; ++i) {
+            data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(0, 20)(generator));
+        }
+
+        auto approximation = matula_mincut_approximator<int64_t>(0.1).approximate(n, data);
+        auto exact = global_mincut_size_dinics(n, data);
+        CHECK_EQ(cut_size(data, approximation.cut), approximation.upper_bound);
+        CHECK_GE(approximation.upper_bound, exact);
+        CHECK_LE(approximation.upper_bound, 2.1 * exact);
+    }
+}
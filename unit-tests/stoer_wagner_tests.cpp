@@ -8,6 +8,7 @@
 using flows_coursework::capacity_edge;
 using flows_coursework::flows_utils::flow_size;
 using flows_coursework::undirected_cuts::cut_size;
+using flows_coursework::undirected_cuts::dense_stoer_wagner_mincut_solver;
 using flows_coursework::undirected_cuts::global_mincut_size_dinics;
 using flows_coursework::undirected_cuts::global_mincut_size_wagner;
 using flows_coursework::undirected_cuts::stoer_wagner_mincut_solver;
@@ -74,3 +75,59 @@ TEST_CASE("stress with dinics") {
         CHECK_EQ(global_mincut_size_wagner(n, data), global_mincut_size_dinics(n, data));
     }
 }
+
+TEST_CASE("stress with parallel edges and self-loops") {
+    int n = 8;
+    int iterations = 300;
+    stoer_wagner_mincut_solver<int64_t> solver;
+
+    while (iterations--) {
+        std::vector<capacity_edge<int64_t>> data;
+        for (int i = 0; i < 4 * n; ++i) {
+            data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(0, 99)(generator));
+        }
+
+        CHECK_EQ(cut_size(data, solver.find_mincut(n, data)), global_mincut_size_dinics(n, data));
+    }
+}
+
+TEST_CASE("dense solver stress with dinics") {
+    int iterations = 300;
+    dense_stoer_wagner_mincut_solver<int64_t> solver;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 10)(generator);
+        std::vector<capacity_edge<int64_t>> data;
+        for (int i = 0; i < 3 * n; ++i) {
+            data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(0, 99)(generator));
+        }
+
+        CHECK_EQ(cut_size(data, solver.find_mincut(n, data)), global_mincut_size_dinics(n, data));
+    }
+}
+
+TEST_CASE("dinics oracle on large sparse graphs") {
+    int n = 1000;
+    int iterations = 2;
+
+    while (iterations--) {
+        std::vector<capacity_edge<int64_t>> data;
+        for (int i = 1; i < n; ++i) {
+            data.emplace_back(std::uniform_int_distribution<int>(0, i - 1)(generator), i,
+                              std::uniform_int_distribution<int64_t>(1, 99)(generator));
+        }
+        for (int i = 0; i < 4 * n; ++i) {
+            data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(1, 99)(generator));
+        }
+
+        auto expected = global_mincut_size_wagner(n, data);
+        CHECK_EQ(global_mincut_size_dinics(n, data, 1), expected);
+        CHECK_EQ(global_mincut_size_dinics(n, data, 4), expected);
+    }
+}
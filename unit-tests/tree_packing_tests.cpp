@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <doctest.h>
+#include <random>
+#include <vector>
+
+#include "../tree_packing.hpp"
+
+using flows_coursework::capacity_edge;
+using flows_coursework::undirected_cuts::cut_size;
+using flows_coursework::undirected_cuts::global_mincut_size_dinics;
+using flows_coursework::undirected_cuts::global_mincut_size_wagner;
+using flows_coursework::undirected_cuts::tree_packing_mincut_solver;
+
+static std::mt19937 generator{38}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+TEST_CASE("cut crossing two edges of a cycle") {
+    int n = 50;
+
+    std::vector<capacity_edge<int64_t>> data;
+    for (int i = 0; i < n; ++i) {
+        data.emplace_back(i, (i + 1) % n, i == 10 || i == 30 ? 1 : 5);
+    }
+
+    auto cut = tree_packing_mincut_solver<int64_t>().find_mincut(n, data);
+    CHECK_EQ(cut_size(data, cut), 2);
+    CHECK_EQ(cut[11], cut[30]);
+    CHECK_NE(cut[10], cut[11]);
+}
+
+TEST_CASE("complete graph packs many trees") {
+    int n = 40;
+
+    std::vector<capacity_edge<int64_t>> data;
+    for (int u = 0; u < n; ++u) {
+        for (int v = u + 1; v < n; ++v) {
+            data.emplace_back(u, v, 1);
+        }
+    }
+
+    auto cut = tree_packing_mincut_solver<int64_t>().find_mincut(n, data);
+    CHECK_EQ(cut_size(data, cut), n - 1);
+}
+
+TEST_CASE("stress with dinics") {
+    int iterations = 1000;
+
+    while (iterations--) {
+        int n = std::uniform_int_distribution<int>(2, 12)(generator);
+        int m = std::uniform_int_distribution<int>(1, 5 * n)(generator);
+
+        std::vector<capacity_edge<int64_t>> data;
+        for (int i = 0; i < m; ++i) {
+            data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(0, 20)(generator));
+        }
+
+        auto cut = tree_packing_mincut_solver<int64_t>().find_mincut(n, data);
+        CHECK_EQ(cut_size(data, cut), global_mincut_size_dinics(n, data));
+    }
+}
+
+TEST_CASE("stress with stoer-wagner") {
+    int iterations = 30;
+
+    while (iterations--) {
+        int n = 300;
+
+        std::vector<capacity_edge<int64_t>> data;
+        for (int i = 1; i < n; ++i) {
+            data.emplace_back(i, std::uniform_int_distribution<int>(0, i - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(1, 100)(generator));
+        }
+        for (int i = 0; i < 3 * n; ++i) {
+            data.emplace_back(std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(1, 100)(generator));
+        }
+
+        auto cut = tree_packing_mincut_solver<int64_t>().find_mincut(n, data);
+        CHECK_EQ(cut_size(data, cut), global_mincut_size_wagner(n, data));
+    }
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstdint>
+#include <doctest.h>
+#include <random>
+#include <vector>
+
+#include "../unit_capacity_solvers.hpp"
+
+using flows_coursework::capacity_edge;
+using flows_coursework::dinics_solvers::basic_dinics_solver;
+using flows_coursework::flows_utils::flow_size;
+using flows_coursework::unit_capacity_solvers::hopcroft_karp_solver;
+using flows_coursework::unit_capacity_solvers::unit_capacity_solver;
+using flows_coursework::unit_capacity_solvers::unit_dinics_solver;
+
+static std::mt19937 generator{48}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static void check_flow(std::size_t n, std::size_t s, std::size_t t,
+                       const std::vector<capacity_edge<int64_t>> &data,
+                       const std::vector<int64_t> &flow) {
+    REQUIRE_EQ(flow.size(), data.size());
+    std::vector<int64_t> balance(n, 0);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        CHECK(flow[i] >= 0);
+        CHECK(flow[i] <= data[i].capacity);
+        balance[data[i].from] -= flow[i];
+        balance[data[i].to] += flow[i];
+    }
+    for (std::size_t v = 0; v < n; ++v) {
+        if (v != s && v != t) {
+            CHECK_EQ(balance[v], 0);
+        }
+    }
+    CHECK_EQ(flow_size(s, data, flow),
+             flow_size(s, data, basic_dinics_solver<int64_t>().solve(n, s, t, data)));
+}
+
+// left vertices 0..left-1, right ones after them, then the source and the target
+static std::vector<capacity_edge<int64_t>> random_matching_network(std::size_t left,
+                                                                   std::size_t right,
+                                                                   std::size_t m) {
+    std::size_t s = left + right;
+    std::vector<capacity_edge<int64_t>> data;
+    for (std::size_t i = 0; i < m; ++i) {
+        std::size_t u = std::uniform_int_distribution<std::size_t>(0, left - 1)(generator);
+        std::size_t v = std::uniform_int_distribution<std::size_t>(0, right - 1)(generator);
+        data.emplace_back(u, left + v, 1);
+    }
+    for (std::size_t u = 0; u < left; ++u) {
+        data.emplace_back(s, u, 1);
+    }
+    for (std::size_t v = left; v < left + right; ++v) {
+        data.emplace_back(v, s + 1, 1);
+    }
+    std::shuffle(data.begin(), data.end(), generator);
+    return data;
+}
+
+TEST_CASE("hopcroft karp on matching networks") {
+    int iterations = 300;
+
+    while (iterations--) {
+        std::size_t left = std::uniform_int_distribution<std::size_t>(1, 30)(generator);
+        std::size_t right = std::uniform_int_distribution<std::size_t>(1, 30)(generator);
+        std::size_t sides = left + right;
+        std::size_t m = std::uniform_int_distribution<std::size_t>(0, 4 * sides)(generator);
+        auto data = random_matching_network(left, right, m);
+        std::size_t n = sides + 2;
+        std::size_t s = n - 2;
+
+        hopcroft_karp_solver<int64_t> matching;
+        REQUIRE(matching.is_matching_network(n, s, s + 1, data));
+        check_flow(n, s, s + 1, data, matching.solve(n, s, s + 1, data));
+        check_flow(n, s, s + 1, data, unit_dinics_solver<int64_t>().solve(n, s, s + 1, data));
+        check_flow(n, s, s + 1, data, unit_capacity_solver<int64_t>().solve(n, s, s + 1, data));
+    }
+}
+
+TEST_CASE("other shapes are no matching networks") {
+    std::vector<capacity_edge<int64_t>> data{{4, 0, 1}, {4, 1, 1}, {0, 2, 1},
+                                             {1, 3, 1}, {2, 5, 1}, {3, 5, 1}};
+    hopcroft_karp_solver<int64_t> matching;
+    CHECK(matching.is_matching_network(6, 4, 5, data));
+    CHECK_FALSE(matching.is_matching_network(6, 4, 4, data));
+
+    auto with = [&](capacity_edge<int64_t> edge) {
+        auto changed = data;
+        changed.push_back(edge);
+        return matching.is_matching_network(6, 4, 5, changed);
+    };
+    CHECK(with({0, 3, 1}));
+    CHECK(with({0, 3, 0}));
+    CHECK_FALSE(with({4, 0, 1}));
+    CHECK_FALSE(with({2, 5, 1}));
+    CHECK_FALSE(with({0, 1, 1}));
+    CHECK_FALSE(with({2, 3, 1}));
+    CHECK_FALSE(with({3, 0, 1}));
+    CHECK_FALSE(with({4, 5, 1}));
+    CHECK_FALSE(with({0, 4, 1}));
+    CHECK_FALSE(with({5, 3, 1}));
+    CHECK_FALSE(with({0, 5, 1}));
+}
+
+TEST_CASE("unit dinics on random unit networks") {
+    int iterations = 2000;
+
+    while (iterations--) {
+        std::size_t n = std::uniform_int_distribution<std::size_t>(2, 20)(generator);
+        std::size_t m = std::uniform_int_distribution<std::size_t>(0, 5 * n)(generator);
+        std::vector<capacity_edge<int64_t>> data;
+        for (std::size_t i = 0; i < m; ++i) {
+            data.emplace_back(std::uniform_int_distribution<std::size_t>(0, n - 1)(generator),
+                              std::uniform_int_distribution<std::size_t>(0, n - 1)(generator),
+                              std::uniform_int_distribution<int64_t>(0, 1)(generator));
+        }
+        std::size_t s = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+        std::size_t t = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+        if (s == t) {
+            continue;
+        }
+
+        check_flow(n, s, t, data, unit_dinics_solver<int64_t>().solve(n, s, t, data));
+        check_flow(n, s, t, data, unit_capacity_solver<int64_t>().solve(n, s, t, data));
+    }
+}
+
+TEST_CASE("larger capacities fall back") {
+    std::vector<capacity_edge<int64_t>> data{{0, 1, 1}, {1, 2, 3}, {0, 2, 1}, {0, 1, 2}};
+
+    auto flow = unit_capacity_solver<int64_t>().solve(3, 0, 2, data);
+    check_flow(3, 0, 2, data, flow);
+    CHECK_EQ(flow_size(0, data, flow), 4);
+}
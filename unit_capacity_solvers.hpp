@@ -0,0 +1,369 @@
+#ifndef FLOWS_COURSEWORK_UNIT_CAPACITY_SOLVERS_HPP
+#define FLOWS_COURSEWORK_UNIT_CAPACITY_SOLVERS_HPP
+
+#include "dinics_solvers.hpp"
+#include <limits>
+#include <vector>
+
+namespace flows_coursework {
+
+namespace unit_capacity_solvers {
+
+// Dinic's algorithm for networks where every capacity is 0 or 1, in O(m min(sqrt(m), n^(2/3)))
+// and O(m sqrt(n)) when every vertex but the terminals has a single edge in or out. An edge is
+// either full or empty, so the residual network is one bit per edge: arc 2i goes along edge i
+// and is residual while the bit is clear, arc 2i + 1 goes back and is residual while it is set.
+// Every augmenting path saturates all of its arcs, so the search restarts from the source.
+template <typename DataType>
+class unit_dinics_solver final : public flows_solver<DataType> {
+    static constexpr std::size_t UNREACHED = std::numeric_limits<std::size_t>::max();
+
+    std::size_t n_vertices_m = 0;
+    vertex_t source_m = 0;
+    vertex_t target_m = 0;
+    std::vector<std::size_t> offsets_m;
+    std::vector<edge_index_t> arcs_m;
+    std::vector<vertex_t> heads_m;
+    std::vector<bool> full_m;
+    std::vector<std::size_t> distances_m;
+    std::vector<std::size_t> iterators_m;
+    std::vector<vertex_t> queue_m;
+    std::vector<std::size_t> path_m;
+    std::vector<vertex_t> tails_m;
+
+    [[nodiscard]] bool residual(edge_index_t arc) const {
+        return full_m[arc >> 1] == static_cast<bool>(arc & 1);
+    }
+
+    void build(const std::vector<capacity_edge<DataType>> &edges) {
+        offsets_m.assign(n_vertices_m + 1, 0);
+        for (const auto &edge : edges) {
+            if (edge.capacity > DataType{} && edge.from != edge.to) {
+                ++offsets_m[edge.from + 1];
+                ++offsets_m[edge.to + 1];
+            }
+        }
+        for (std::size_t v = 0; v < n_vertices_m; ++v) {
+            offsets_m[v + 1] += offsets_m[v];
+        }
+        arcs_m.resize(offsets_m[n_vertices_m]);
+        heads_m.resize(offsets_m[n_vertices_m]);
+        std::vector<std::size_t> positions(offsets_m.begin(), offsets_m.end() - 1);
+        for (edge_index_t i = 0; i < edges.size(); ++i) {
+            const auto &edge = edges[i];
+            if (edge.capacity > DataType{} && edge.from != edge.to) {
+                arcs_m[positions[edge.from]] = 2 * i;
+                heads_m[positions[edge.from]++] = edge.to;
+                arcs_m[positions[edge.to]] = 2 * i + 1;
+                heads_m[positions[edge.to]++] = edge.from;
+            }
+        }
+        full_m.assign(edges.size(), false);
+    }
+
+    // distances from the source up to the layer of the target, false if it is unreachable
+    bool build_layers() {
+        distances_m.assign(n_vertices_m, UNREACHED);
+        distances_m[source_m] = 0;
+        queue_m.assign(1, source_m);
+        for (std::size_t i = 0; i < queue_m.size(); ++i) {
+            vertex_t current = queue_m[i];
+            if (distances_m[current] >= distances_m[target_m]) {
+                break;
+            }
+            for (std::size_t j = offsets_m[current]; j < offsets_m[current + 1]; ++j) {
+                if (residual(arcs_m[j]) && distances_m[heads_m[j]] == UNREACHED) {
+                    distances_m[heads_m[j]] = distances_m[current] + 1;
+                    queue_m.push_back(heads_m[j]);
+                }
+            }
+        }
+        return distances_m[target_m] != UNREACHED;
+    }
+
+    // augments along paths of the layered network until it is blocked
+    void blocking_flow() {
+        iterators_m.assign(offsets_m.begin(), offsets_m.end() - 1);
+        path_m.clear();
+        tails_m.clear();
+        vertex_t current = source_m;
+        while (true) {
+            if (current == target_m) {
+                for (std::size_t position : path_m) {
+                    full_m[arcs_m[position] >> 1] = !full_m[arcs_m[position] >> 1];
+                }
+                path_m.clear();
+                tails_m.clear();
+                current = source_m;
+                continue;
+            }
+            std::size_t &position = iterators_m[current];
+            if (position == offsets_m[current + 1]) {
+                if (current == source_m) {
+                    return;
+                }
+                // a dead end leaves the layered network
+                distances_m[current] = UNREACHED;
+                current = tails_m.back();
+                tails_m.pop_back();
+                path_m.pop_back();
+                ++iterators_m[current];
+                continue;
+            }
+            if (residual(arcs_m[position]) &&
+                distances_m[heads_m[position]] == distances_m[current] + 1) {
+                path_m.push_back(position);
+                tails_m.push_back(current);
+                current = heads_m[position];
+            } else {
+                ++position;
+            }
+        }
+    }
+
+  public:
+    // every capacity must be 0 or 1
+    std::vector<DataType> solve(std::size_t graph_size, vertex_t source, vertex_t target,
+                                const std::vector<capacity_edge<DataType>> &edges) override {
+        n_vertices_m = graph_size;
+        source_m = source;
+        target_m = target;
+        build(edges);
+        while (source != target && build_layers()) {
+            blocking_flow();
+        }
+
+        std::vector<DataType> result(edges.size());
+        for (edge_index_t i = 0; i < edges.size(); ++i) {
+            result[i] = full_m[i] ? DataType{1} : DataType{};
+        }
+        return result;
+    }
+};
+
+// Hopcroft-Karp on a matching network: every edge of the source goes to a left vertex and every
+// edge of the target comes from a right vertex, at most one per vertex, no vertex is on both
+// sides and every other edge goes from a left vertex to a right one. Each phase finds shortest
+// augmenting paths by a search from all free left vertices at once, O(m sqrt(n)) in total.
+template <typename DataType>
+class hopcroft_karp_solver final : public flows_solver<DataType> {
+    static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+    std::vector<vertex_t> left_m;
+    std::vector<edge_index_t> source_edges_m;
+    std::vector<edge_index_t> target_edges_m;
+    std::vector<std::size_t> offsets_m;
+    std::vector<edge_index_t> adjacent_m;
+    std::vector<vertex_t> heads_m;
+    std::vector<std::size_t> matched_m;
+    std::vector<vertex_t> owners_m;
+    std::vector<std::size_t> distances_m;
+    std::vector<std::size_t> iterators_m;
+    std::vector<vertex_t> queue_m;
+    std::vector<vertex_t> path_m;
+
+    // fills edges of the terminals, false if the network is not a matching network
+    bool classify(std::size_t graph_size, vertex_t source, vertex_t target,
+                  const std::vector<capacity_edge<DataType>> &edges) {
+        source_edges_m.assign(graph_size, NONE);
+        target_edges_m.assign(graph_size, NONE);
+        if (source == target) {
+            return false;
+        }
+        for (edge_index_t i = 0; i < edges.size(); ++i) {
+            const auto &edge = edges[i];
+            if (edge.capacity <= DataType{}) {
+                continue;
+            }
+            if (edge.to == source || edge.from == target) {
+                return false;
+            }
+            if (edge.from == source) {
+                if (edge.to == target || source_edges_m[edge.to] != NONE) {
+                    return false;
+                }
+                source_edges_m[edge.to] = i;
+            } else if (edge.to == target) {
+                if (target_edges_m[edge.from] != NONE) {
+                    return false;
+                }
+                target_edges_m[edge.from] = i;
+            }
+        }
+        for (vertex_t v = 0; v < graph_size; ++v) {
+            if (source_edges_m[v] != NONE && target_edges_m[v] != NONE) {
+                return false;
+            }
+        }
+        for (const auto &edge : edges) {
+            if (edge.capacity > DataType{} && edge.from != source && edge.to != target &&
+                (source_edges_m[edge.from] == NONE || target_edges_m[edge.to] == NONE)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void build(std::size_t graph_size, vertex_t source, vertex_t target,
+               const std::vector<capacity_edge<DataType>> &edges) {
+        left_m.clear();
+        for (vertex_t v = 0; v < graph_size; ++v) {
+            if (source_edges_m[v] != NONE) {
+                left_m.push_back(v);
+            }
+        }
+        offsets_m.assign(graph_size + 1, 0);
+        for (const auto &edge : edges) {
+            if (edge.capacity > DataType{} && edge.from != source && edge.to != target) {
+                ++offsets_m[edge.from + 1];
+            }
+        }
+        for (vertex_t v = 0; v < graph_size; ++v) {
+            offsets_m[v + 1] += offsets_m[v];
+        }
+        adjacent_m.resize(offsets_m[graph_size]);
+        heads_m.resize(offsets_m[graph_size]);
+        std::vector<std::size_t> positions(offsets_m.begin(), offsets_m.end() - 1);
+        for (edge_index_t i = 0; i < edges.size(); ++i) {
+            const auto &edge = edges[i];
+            if (edge.capacity > DataType{} && edge.from != source && edge.to != target) {
+                adjacent_m[positions[edge.from]] = i;
+                heads_m[positions[edge.from]++] = edge.to;
+            }
+        }
+    }
+
+    // layers of left vertices from the free ones, false if no free right vertex is reached
+    bool build_layers() {
+        queue_m.clear();
+        for (vertex_t u : left_m) {
+            distances_m[u] = matched_m[u] == NONE ? 0 : NONE;
+            if (matched_m[u] == NONE) {
+                queue_m.push_back(u);
+            }
+        }
+        bool found = false;
+        for (std::size_t i = 0; i < queue_m.size(); ++i) {
+            vertex_t current = queue_m[i];
+            for (std::size_t j = offsets_m[current]; j < offsets_m[current + 1]; ++j) {
+                vertex_t owner = owners_m[heads_m[j]];
+                if (owner == NONE) {
+                    found = true;
+                } else if (distances_m[owner] == NONE) {
+                    distances_m[owner] = distances_m[current] + 1;
+                    queue_m.push_back(owner);
+                }
+            }
+        }
+        return found;
+    }
+
+    // an augmenting path of the layers from a free left vertex, flipped along the way
+    bool augment(vertex_t root) {
+        path_m.assign(1, root);
+        while (!path_m.empty()) {
+            vertex_t current = path_m.back();
+            std::size_t &position = iterators_m[current];
+            if (position == offsets_m[current + 1]) {
+                distances_m[current] = NONE;
+                path_m.pop_back();
+                if (!path_m.empty()) {
+                    ++iterators_m[path_m.back()];
+                }
+                continue;
+            }
+            vertex_t owner = owners_m[heads_m[position]];
+            if (owner == NONE) {
+                for (vertex_t u : path_m) {
+                    matched_m[u] = iterators_m[u];
+                    owners_m[heads_m[iterators_m[u]]] = u;
+                }
+                return true;
+            }
+            if (distances_m[owner] == distances_m[current] + 1) {
+                path_m.push_back(owner);
+            } else {
+                ++position;
+            }
+        }
+        return false;
+    }
+
+  public:
+    // cheap check of the shape the solver requires
+    [[nodiscard]] bool is_matching_network(std::size_t graph_size, vertex_t source,
+                                           vertex_t target,
+                                           const std::vector<capacity_edge<DataType>> &edges) {
+        return classify(graph_size, source, target, edges);
+    }
+
+    // the network must be a matching network
+    std::vector<DataType> solve(std::size_t graph_size, vertex_t source, vertex_t target,
+                                const std::vector<capacity_edge<DataType>> &edges) override {
+        std::vector<DataType> result(edges.size());
+        if (!classify(graph_size, source, target, edges)) {
+            return result;
+        }
+        build(graph_size, source, target, edges);
+        matched_m.assign(graph_size, NONE);
+        owners_m.assign(graph_size, NONE);
+        distances_m.assign(graph_size, NONE);
+
+        // greedy start, the phases only fix what it missed
+        for (vertex_t u : left_m) {
+            for (std::size_t j = offsets_m[u]; j < offsets_m[u + 1]; ++j) {
+                if (owners_m[heads_m[j]] == NONE) {
+                    matched_m[u] = j;
+                    owners_m[heads_m[j]] = u;
+                    break;
+                }
+            }
+        }
+        while (build_layers()) {
+            iterators_m.assign(offsets_m.begin(), offsets_m.end() - 1);
+            for (vertex_t u : left_m) {
+                if (matched_m[u] == NONE) {
+                    augment(u);
+                }
+            }
+        }
+
+        for (vertex_t u : left_m) {
+            if (matched_m[u] != NONE) {
+                result[adjacent_m[matched_m[u]]] = 1;
+                result[source_edges_m[u]] = 1;
+                result[target_edges_m[heads_m[matched_m[u]]]] = 1;
+            }
+        }
+        return result;
+    }
+};
+
+// Runs Hopcroft-Karp on matching networks, unit Dinic's on other networks whose capacities are
+// all 0 or 1 and Fallback on the rest, so flow values are those of the general solvers.
+template <typename DataType, typename Fallback = dinics_solvers::basic_dinics_solver<DataType>>
+class unit_capacity_solver final : public flows_solver<DataType> {
+    hopcroft_karp_solver<DataType> matching_m;
+    unit_dinics_solver<DataType> unit_m;
+    Fallback fallback_m;
+
+  public:
+    std::vector<DataType> solve(std::size_t graph_size, vertex_t source, vertex_t target,
+                                const std::vector<capacity_edge<DataType>> &edges) override {
+        for (const auto &edge : edges) {
+            if (edge.capacity != DataType{} && edge.capacity != DataType{1}) {
+                return fallback_m.solve(graph_size, source, target, edges);
+            }
+        }
+        if (matching_m.is_matching_network(graph_size, source, target, edges)) {
+            return matching_m.solve(graph_size, source, target, edges);
+        }
+        return unit_m.solve(graph_size, source, target, edges);
+    }
+};
+
+} // namespace unit_capacity_solvers
+
+} // namespace flows_coursework
+
+#endif // FLOWS_COURSEWORK_UNIT_CAPACITY_SOLVERS_HPP